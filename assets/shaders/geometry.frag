@@ -34,10 +34,27 @@ struct MaterialData {
 
 uniform MaterialData material;
 
+// Compact G-buffer (GBufferLayout::COMPACT): no position target, normals octahedral-encoded into RG16
+uniform bool compactGBuffer;
+
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// Folds the unit sphere onto the [-1, 1] square: upper hemisphere as the inner diamond, lower one on the corners
+vec2 octahedralEncode(vec3 n) {
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    return n.z >= 0.0 ? n.xy : (1.0 - abs(n.yx)) * signNotZero(n.xy);
+}
+
 void main() {
     gPosition = vec4(FragPos, 1.0);
 
-    gNormal = vec4(normalize(Normal), 1.0);
+    if (compactGBuffer) {
+        gNormal = vec4(octahedralEncode(normalize(Normal)) * 0.5 + 0.5, 0.0, 1.0);
+    } else {
+        gNormal = vec4(normalize(Normal), 1.0);
+    }
 
     vec3 albedo;
     if (material.hasAlbedoMap) {
@@ -2,19 +2,29 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+// Per-instance model matrix, one column per location (3-6)
+layout (location = 3) in mat4 aInstanceModel;
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    mat4 inverseViewProjection;
+    vec3 viewPos;
+};
+// Instanced draws take the model matrix from aInstanceModel, single draws from the model uniform
+uniform bool instanced;
 
 void main() {
-    vec4 worldPos = model * vec4(aPos, 1.0);
+    mat4 modelMatrix = instanced ? aInstanceModel : model;
+    vec4 worldPos = modelMatrix * vec4(aPos, 1.0);
     FragPos = worldPos.xyz;
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    Normal = mat3(transpose(inverse(modelMatrix))) * aNormal;
     TexCoords = aTexCoords;
     gl_Position = projection * view * worldPos;
 }
\ No newline at end of file
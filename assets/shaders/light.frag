@@ -14,34 +14,79 @@ uniform sampler2D brdfLUT;
 
 const float MAX_REFLECTION_LOD = 4.0;
 
-uniform vec3 viewPos;
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    mat4 inverseViewProjection;
+    vec3 viewPos;
+};
 
 // Make sure to match these from light manager
-#define MAX_POINT_LIGHTS 16
+#define MAX_POINT_LIGHTS 256
 #define MAX_DIR_LIGHTS 1
 
+// Members ordered so each struct packs into 32 bytes under std140 (LightManager::GpuDirectionalLight/GpuPointLight)
 struct DirectionalLight {
     vec3 direction;
-    vec3 color;
     bool enabled;
+    vec3 color;
 };
 
 struct PointLight {
     vec3 position;
-    vec3 color;
     float radius;
+    vec3 color;
     bool enabled;
 };
 
-uniform DirectionalLight dirLights[MAX_DIR_LIGHTS];
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
-uniform int numDirLights;
-uniform int numPointLights;
+layout (std140) uniform LightData {
+    int numDirLights;
+    int numPointLights;
+    DirectionalLight dirLights[MAX_DIR_LIGHTS];
+    PointLight pointLights[MAX_POINT_LIGHTS];
+};
+
+// Clustered point lights (LightGrid): per cluster an (offset, count) pair into the list of light indices.
+// Make sure to match these from light grid
+#define CLUSTER_TILES_X 16
+#define CLUSTER_TILES_Y 9
+#define CLUSTER_SLICES 24
+
+uniform usamplerBuffer clusterGrid;
+uniform usamplerBuffer clusterLights;
+uniform vec2 clusterTileSize;
+uniform float clusterSliceScale;
+uniform float clusterSliceBias;
+
+// Set when point lights are drawn afterwards as light volumes (LightVolumes): skip them here and write linear HDR
+// for the volumes to add onto, leaving tone mapping to the resolve pass
+uniform bool pointLightVolumes;
+
+// Compact G-buffer (GBufferLayout::COMPACT): position comes from gDepth, normals are octahedral-encoded in RG16
+uniform bool compactGBuffer;
+uniform sampler2D gDepth;
+
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec3 octahedralDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(n.yx)) * signNotZero(n.xy);
+    }
+    return normalize(n);
+}
+
+vec3 reconstructPosition(vec2 uv, float depth) {
+    vec4 world = inverseViewProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    return world.xyz / world.w;
+}
 
 const float PI = 3.14159265359;
 
 uniform sampler2D shadowMap;
-uniform mat4 lightSpaceMatrix;
 
 // PBR Functions
 float DistributionGGX(vec3 N, vec3 H, float roughness) {
@@ -134,9 +179,16 @@ float shadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDir) {
 
 void main() {
     // Sample G-Buffer
-    vec3 FragPos = texture(gPosition, TexCoords).rgb;
+    vec3 FragPos;
+    vec3 Normal;
+    if (compactGBuffer) {
+        FragPos = reconstructPosition(TexCoords, texture(gDepth, TexCoords).r);
+        Normal = octahedralDecode(texture(gNormal, TexCoords).rg * 2.0 - 1.0);
+    } else {
+        FragPos = texture(gPosition, TexCoords).rgb;
+        Normal = normalize(texture(gNormal, TexCoords).rgb);
+    }
     vec4 FragPosLightSpace = lightSpaceMatrix * vec4(FragPos, 1.0);
-    vec3 Normal = normalize(texture(gNormal, TexCoords).rgb);
     vec3 Albedo = texture(gAlbedo, TexCoords).rgb;
     vec2 MetallicRoughness = texture(gMetallicRoughness, TexCoords).rg;
     float Metallic = MetallicRoughness.r;
@@ -161,9 +213,15 @@ void main() {
         accumLight += (1.0 - shadow) * calculateLighting(L, radiance, Normal, View, F0, Albedo, Metallic, Roughness);
     }
 
-    // Point lights
-    for (int i = 0; i < numPointLights; i++) {
-        if (!pointLights[i].enabled) continue;
+    // Point lights, only those whose radius reaches this pixel's cluster
+    float viewDepth = max(-(view * vec4(FragPos, 1.0)).z, 1e-4);
+    ivec2 tile = min(ivec2(gl_FragCoord.xy / clusterTileSize), ivec2(CLUSTER_TILES_X - 1, CLUSTER_TILES_Y - 1));
+    int slice = clamp(int(floor(log(viewDepth) * clusterSliceScale - clusterSliceBias)), 0, CLUSTER_SLICES - 1);
+    uvec2 cluster = texelFetch(clusterGrid, tile.x + CLUSTER_TILES_X * (tile.y + CLUSTER_TILES_Y * slice)).rg;
+
+    uint clusterLightCount = pointLightVolumes ? 0u : cluster.y;
+    for (uint j = 0u; j < clusterLightCount; j++) {
+        int i = int(texelFetch(clusterLights, int(cluster.x + j)).r);
 
         vec3 L = normalize(pointLights[i].position - FragPos);
         float distance = length(pointLights[i].position - FragPos);
@@ -192,6 +250,11 @@ void main() {
 
     vec3 color = ambient + accumLight;
 
+    if (pointLightVolumes) {
+        FragColor = vec4(color, 1.0);
+        return;
+    }
+
     // Tone mapping
     color = color / (color + vec3(1.0));
     // Gamma correction
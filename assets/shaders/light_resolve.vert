@@ -0,0 +1,10 @@
+#version 330 core
+
+out vec2 TexCoords;
+
+void main() {
+    // One triangle covering the screen: (-1,-1), (3,-1), (-1,3)
+    vec2 position = vec2((gl_VertexID & 1) * 4.0 - 1.0, (gl_VertexID >> 1) * 4.0 - 1.0);
+    TexCoords = position * 0.5 + 0.5;
+    gl_Position = vec4(position, 0.0, 1.0);
+}
@@ -0,0 +1,161 @@
+#version 330 core
+out vec4 FragColor;
+
+uniform sampler2D gPosition;
+uniform sampler2D gNormal;
+uniform sampler2D gAlbedo;
+uniform sampler2D gMetallicRoughness;
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    mat4 inverseViewProjection;
+    vec3 viewPos;
+};
+
+// Make sure to match these from light manager
+#define MAX_POINT_LIGHTS 256
+#define MAX_DIR_LIGHTS 1
+
+struct DirectionalLight {
+    vec3 direction;
+    bool enabled;
+    vec3 color;
+};
+
+struct PointLight {
+    vec3 position;
+    float radius;
+    vec3 color;
+    bool enabled;
+};
+
+layout (std140) uniform LightData {
+    int numDirLights;
+    int numPointLights;
+    DirectionalLight dirLights[MAX_DIR_LIGHTS];
+    PointLight pointLights[MAX_POINT_LIGHTS];
+};
+
+uniform int lightIndex;
+
+// Compact G-buffer (GBufferLayout::COMPACT): position comes from gDepth, normals are octahedral-encoded in RG16
+uniform bool compactGBuffer;
+uniform sampler2D gDepth;
+
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
+
+vec3 octahedralDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(n.yx)) * signNotZero(n.xy);
+    }
+    return normalize(n);
+}
+
+vec3 reconstructPosition(vec2 uv, float depth) {
+    vec4 world = inverseViewProjection * vec4(vec3(uv, depth) * 2.0 - 1.0, 1.0);
+    return world.xyz / world.w;
+}
+
+const float PI = 3.14159265359;
+
+// Same BRDF as light.frag
+// PBR Functions
+float DistributionGGX(vec3 N, vec3 H, float roughness) {
+    float a = roughness * roughness;
+    float a2 = a * a;
+    float NdotH = max(dot(N, H), 0.0);
+    float NdotH2 = NdotH * NdotH;
+
+    float num = a2;
+    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
+    denom = PI * denom * denom;
+
+    return num / denom;
+}
+
+float GeometrySchlickGGX(float NdotV, float roughness) {
+    float r = (roughness + 1.0);
+    float k = (r * r) / 8.0;
+
+    float num = NdotV;
+    float denom = NdotV * (1.0 - k) + k;
+
+    return num / denom;
+}
+
+float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness) {
+    float NdotV = max(dot(N, V), 0.0);
+    float NdotL = max(dot(N, L), 0.0);
+    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
+    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
+
+    return ggx1 * ggx2;
+}
+
+vec3 fresnelSchlick(float cosTheta, vec3 F0) {
+    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
+
+// Calculate lighting contribution from a single light
+vec3 calculateLighting(vec3 L, vec3 radiance, vec3 N, vec3 V, vec3 F0, vec3 albedo, float metallic, float roughness) {
+    vec3 H = normalize(V + L);
+
+    // Cook-Torrance BRDF
+    float NDF = DistributionGGX(N, H, roughness);
+    float G = GeometrySmith(N, V, L, roughness);
+    vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+
+    vec3 kS = F;
+    vec3 kD = vec3(1.0) - kS;
+    kD *= 1.0 - metallic;
+
+    vec3 numerator = NDF * G * F;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * max(dot(N, L), 0.0) + 0.0001;
+    vec3 specular = numerator / denominator;
+
+    float NdotL = max(dot(N, L), 0.0);
+    return (kD * albedo / PI + specular) * radiance * NdotL;
+}
+
+void main() {
+    // Drawn over the light's sphere, so read the G-buffer at this pixel
+    ivec2 pixel = ivec2(gl_FragCoord.xy);
+    vec3 FragPos;
+    vec3 Normal;
+    if (compactGBuffer) {
+        vec2 uv = (vec2(pixel) + 0.5) / vec2(textureSize(gDepth, 0));
+        FragPos = reconstructPosition(uv, texelFetch(gDepth, pixel, 0).r);
+        Normal = octahedralDecode(texelFetch(gNormal, pixel, 0).rg * 2.0 - 1.0);
+    } else {
+        FragPos = texelFetch(gPosition, pixel, 0).rgb;
+        Normal = normalize(texelFetch(gNormal, pixel, 0).rgb);
+    }
+    vec3 Albedo = texelFetch(gAlbedo, pixel, 0).rgb;
+    vec2 MetallicRoughness = texelFetch(gMetallicRoughness, pixel, 0).rg;
+    float Metallic = MetallicRoughness.r;
+    float Roughness = MetallicRoughness.g;
+
+    vec3 View = normalize(viewPos - FragPos);
+
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, Albedo, Metallic);
+
+    PointLight light = pointLights[lightIndex];
+    vec3 L = normalize(light.position - FragPos);
+    float distance = length(light.position - FragPos);
+
+    float attenuation = 1.0 / (distance * distance);
+    float falloff = clamp(1.0 - (distance / light.radius), 0.0, 1.0);
+    falloff = falloff * falloff;
+    attenuation *= falloff;
+
+    vec3 radiance = light.color * attenuation;
+
+    // Added onto the accumulated light; tone mapping happens once all lights are in
+    FragColor = vec4(calculateLighting(L, radiance, Normal, View, F0, Albedo, Metallic, Roughness), 0.0);
+}
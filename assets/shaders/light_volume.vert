@@ -0,0 +1,42 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    mat4 inverseViewProjection;
+    vec3 viewPos;
+};
+
+// Make sure to match these from light manager
+#define MAX_POINT_LIGHTS 256
+#define MAX_DIR_LIGHTS 1
+
+struct DirectionalLight {
+    vec3 direction;
+    bool enabled;
+    vec3 color;
+};
+
+struct PointLight {
+    vec3 position;
+    float radius;
+    vec3 color;
+    bool enabled;
+};
+
+layout (std140) uniform LightData {
+    int numDirLights;
+    int numPointLights;
+    DirectionalLight dirLights[MAX_DIR_LIGHTS];
+    PointLight pointLights[MAX_POINT_LIGHTS];
+};
+
+uniform int lightIndex;
+
+void main() {
+    // Unit sphere mesh (already enlarged to contain the unit sphere) scaled to the light's radius
+    vec3 worldPos = pointLights[lightIndex].position + aPos * pointLights[lightIndex].radius;
+    gl_Position = projection * view * vec4(worldPos, 1.0);
+}
@@ -0,0 +1,5 @@
+#version 330 core
+
+// Stencil-only pass; color writes are masked off
+void main() {
+}
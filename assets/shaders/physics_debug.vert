@@ -5,8 +5,13 @@ layout (location = 1) in vec3 aColor;
 out vec3 Color;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 lightSpaceMatrix;
+    mat4 inverseViewProjection;
+    vec3 viewPos;
+};
 
 void main() {
     Color = aColor;
@@ -0,0 +1,29 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+// Same flags as google benchmark's own main, except that the results are also written to DuckEngineBench.json
+// unless --benchmark_out is given, so every run leaves a file to compare against the previous one.
+int main(int argc, char** argv) {
+    std::vector<char*> args(argv, argv + argc);
+
+    bool bHasOut = false;
+    for (char* arg : args) {
+        if (std::strncmp(arg, "--benchmark_out=", 16) == 0) bHasOut = true;
+    }
+
+    static char defaultOut[] = "--benchmark_out=DuckEngineBench.json";
+    static char defaultOutFormat[] = "--benchmark_out_format=json";
+    if (!bHasOut) {
+        args.push_back(defaultOut);
+        args.push_back(defaultOutFormat);
+    }
+
+    int argCount = static_cast<int>(args.size());
+    benchmark::Initialize(&argCount, args.data());
+    if (benchmark::ReportUnrecognizedArguments(argCount, args.data())) return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+#include "../src/engine/ecs/World.h"
+#include "../src/engine/ecs/Entity.h"
+#include "../src/engine/ecs/components/Transform.h"
+#include "../src/engine/ecs/components/Velocity.h"
+#include "../src/engine/ecs/components/BoxCollider.h"
+
+// Scene setup shared by the benchmarks. Everything random comes from a fixed seed, so two runs of the same
+// binary measure the same scene.
+namespace Bench {
+    constexpr std::uint32_t SEED = 0xD0C4;
+
+    // Entity counts every ECS benchmark is run with.
+    constexpr int MIN_ENTITIES = 1'000;
+    constexpr int MAX_ENTITIES = 1'000'000;
+
+    // Heap allocated: World owns a job system and is far too large for the stack.
+    inline std::unique_ptr<World> makeWorld()
+    {
+        return std::make_unique<World>();
+    }
+
+    // Side of the cube entities are scattered in, growing with the count so the density stays the same.
+    inline float getSceneExtent(int entityCount)
+    {
+        return 3.0f * std::cbrt(static_cast<float>(entityCount));
+    }
+
+    inline glm::vec3 randomPoint(std::mt19937& rng, float extent)
+    {
+        std::uniform_real_distribution<float> coordinate(-0.5f * extent, 0.5f * extent);
+        return glm::vec3(coordinate(rng), coordinate(rng), coordinate(rng));
+    }
+
+    inline glm::vec3 randomDirection(std::mt19937& rng)
+    {
+        std::normal_distribution<float> axis(0.0f, 1.0f);
+        glm::vec3 direction(axis(rng), axis(rng), axis(rng));
+        return glm::length(direction) > 0.0001f ? glm::normalize(direction) : glm::vec3(0.0f, 0.0f, -1.0f);
+    }
+
+    inline Entity& createMovingEntity(World& world, std::mt19937& rng, float extent)
+    {
+        Entity& entity = world.EntityManager.CreateEntity(world);
+        entity.addComponent<Transform>().position = randomPoint(rng, extent);
+        entity.addComponent<Velocity>(randomDirection(rng), 2.0f);
+        return entity;
+    }
+
+    // Unit boxes, one in staticEvery of them static, synced into the collision BVHs before returning.
+    inline void populateColliders(World& world, int entityCount, int staticEvery = 4)
+    {
+        std::mt19937 rng(SEED);
+        float extent = getSceneExtent(entityCount);
+
+        for (int i = 0; i < entityCount; ++i) {
+            Entity& entity = world.EntityManager.CreateEntity(world);
+            entity.addComponent<Transform>().position = randomPoint(rng, extent);
+            entity.addComponent<BoxCollider>().isStatic = i % staticEvery == 0;
+        }
+
+        world.collisionSystem->update(world, 0.0f);
+    }
+}
@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+#include <cfloat>
+#include <vector>
+
+#include "BenchWorld.h"
+#include "../src/engine/ecs/system/CollisionSystem.h"
+#include "../src/engine/physics/RaycastUtils.h"
+
+namespace {
+    // Queries are cycled through a fixed set so generating them stays out of the timed loop.
+    constexpr std::size_t QUERY_COUNT = 4096;
+
+    void BM_CollisionRaycast(benchmark::State& state)
+    {
+        int entityCount = static_cast<int>(state.range(0));
+        auto world = Bench::makeWorld();
+        Bench::populateColliders(*world, entityCount);
+
+        std::mt19937 rng(Bench::SEED + 1);
+        float extent = Bench::getSceneExtent(entityCount);
+        std::vector<CollisionSystem::RayQuery> rays(QUERY_COUNT);
+        for (auto& ray : rays) {
+            ray.origin = Bench::randomPoint(rng, extent);
+            ray.direction = Bench::randomDirection(rng);
+        }
+
+        std::size_t next = 0;
+        std::int64_t hits = 0;
+        for (auto _ : state) {
+            const auto& ray = rays[next];
+            next = (next + 1) % QUERY_COUNT;
+
+            auto result = world->collisionSystem->Raycast(world->EntityManager, ray.origin, ray.direction,
+                                                          ray.maxDistance);
+            hits += result.hit;
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.counters["hitRate"] = benchmark::Counter(static_cast<double>(hits) / state.iterations());
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Boxes of about four entities each at the scene's density.
+    void BM_CollisionGetEntitiesInBox(benchmark::State& state)
+    {
+        int entityCount = static_cast<int>(state.range(0));
+        auto world = Bench::makeWorld();
+        Bench::populateColliders(*world, entityCount);
+
+        std::mt19937 rng(Bench::SEED + 2);
+        float extent = Bench::getSceneExtent(entityCount);
+        glm::vec3 halfSize(2.4f);
+        std::vector<glm::vec3> centers(QUERY_COUNT);
+        for (auto& center : centers) {
+            center = Bench::randomPoint(rng, extent);
+        }
+
+        std::size_t next = 0;
+        std::int64_t found = 0;
+        for (auto _ : state) {
+            const glm::vec3& center = centers[next];
+            next = (next + 1) % QUERY_COUNT;
+
+            auto entities = world->collisionSystem->GetEntitiesInBox(world->EntityManager,
+                                                                     center - halfSize, center + halfSize);
+            found += static_cast<std::int64_t>(entities.size());
+            benchmark::DoNotOptimize(entities.data());
+        }
+
+        state.counters["entitiesPerQuery"] = benchmark::Counter(static_cast<double>(found) / state.iterations());
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // One ray against every box of a scene, the way a brute-force closest-hit query would test them.
+    struct RayBoxScene {
+        std::vector<glm::vec3> mins;
+        std::vector<glm::vec3> maxs;
+        Physics::AABBBatch batch;
+        std::vector<CollisionSystem::RayQuery> rays;
+    };
+
+    RayBoxScene makeRayBoxScene(int boxCount)
+    {
+        RayBoxScene scene;
+        std::mt19937 rng(Bench::SEED + 3);
+        float extent = Bench::getSceneExtent(boxCount);
+        for (int i = 0; i < boxCount; ++i) {
+            glm::vec3 center = Bench::randomPoint(rng, extent);
+            scene.mins.push_back(center - glm::vec3(0.5f));
+            scene.maxs.push_back(center + glm::vec3(0.5f));
+            scene.batch.add(scene.mins.back(), scene.maxs.back());
+        }
+        scene.rays.resize(QUERY_COUNT);
+        for (auto& ray : scene.rays) {
+            ray.origin = Bench::randomPoint(rng, extent);
+            ray.direction = Bench::randomDirection(rng);
+        }
+        return scene;
+    }
+
+    void BM_RaycastAABB(benchmark::State& state)
+    {
+        RayBoxScene scene = makeRayBoxScene(static_cast<int>(state.range(0)));
+
+        std::size_t next = 0;
+        for (auto _ : state) {
+            const auto& ray = scene.rays[next];
+            next = (next + 1) % QUERY_COUNT;
+
+            int closestIndex = -1;
+            float closestDistance = FLT_MAX;
+            for (std::size_t box = 0; box < scene.mins.size(); ++box) {
+                Physics::RaycastHit hit = Physics::raycastAABB(ray.origin, ray.direction, scene.mins[box], scene.maxs[box]);
+                if (hit.hit && hit.distance < closestDistance) {
+                    closestDistance = hit.distance;
+                    closestIndex = static_cast<int>(box);
+                }
+            }
+            benchmark::DoNotOptimize(closestIndex);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_RaycastAABBBatch(benchmark::State& state)
+    {
+        RayBoxScene scene = makeRayBoxScene(static_cast<int>(state.range(0)));
+        state.SetLabel(Physics::getRaycastBatchKernelName());
+
+        std::size_t next = 0;
+        for (auto _ : state) {
+            const auto& ray = scene.rays[next];
+            next = (next + 1) % QUERY_COUNT;
+
+            int closestIndex = Physics::raycastAABBBatch(ray.origin, ray.direction, scene.batch, FLT_MAX);
+            benchmark::DoNotOptimize(closestIndex);
+        }
+
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+BENCHMARK(BM_CollisionRaycast)
+    ->RangeMultiplier(10)->Range(Bench::MIN_ENTITIES, Bench::MAX_ENTITIES)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_CollisionGetEntitiesInBox)
+    ->RangeMultiplier(10)->Range(Bench::MIN_ENTITIES, Bench::MAX_ENTITIES)
+    ->Unit(benchmark::kMicrosecond);
+
+// Items are boxes tested, so the two are directly comparable.
+BENCHMARK(BM_RaycastAABB)
+    ->RangeMultiplier(8)->Range(8, 32'768);
+
+BENCHMARK(BM_RaycastAABBBatch)
+    ->RangeMultiplier(8)->Range(8, 32'768);
@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+
+#include "BenchWorld.h"
+#include "../src/engine/ecs/components/HealthComponent.h"
+
+namespace {
+    // Creating entities with a Transform and a Velocity; the cleanup between iterations is not timed.
+    void BM_CreateEntity(benchmark::State& state)
+    {
+        int entityCount = static_cast<int>(state.range(0));
+        auto world = Bench::makeWorld();
+        float extent = Bench::getSceneExtent(entityCount);
+
+        for (auto _ : state) {
+            std::mt19937 rng(Bench::SEED);
+            for (int i = 0; i < entityCount; ++i) {
+                Bench::createMovingEntity(*world, rng, extent);
+            }
+
+            state.PauseTiming();
+            for (auto& entity : world->EntityManager.GetEntities()) {
+                entity->destroy();
+            }
+            world->EntityManager.CleanupInactiveEntities();
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(state.iterations() * entityCount);
+    }
+
+    // Deleting every other entity of the list, the worst case for the swap-and-pop cleanup.
+    void BM_CleanupInactiveEntities(benchmark::State& state)
+    {
+        int entityCount = static_cast<int>(state.range(0));
+        auto world = Bench::makeWorld();
+        float extent = Bench::getSceneExtent(entityCount);
+        std::mt19937 rng(Bench::SEED);
+
+        for (int i = 0; i < entityCount; ++i) {
+            Bench::createMovingEntity(*world, rng, extent);
+        }
+
+        for (auto _ : state) {
+            state.PauseTiming();
+            auto& entities = world->EntityManager.GetEntities();
+            for (std::size_t i = 0; i < entities.size(); i += 2) {
+                entities[i]->destroy();
+            }
+            state.ResumeTiming();
+
+            world->EntityManager.CleanupInactiveEntities();
+
+            state.PauseTiming();
+            for (int i = 0; i < (entityCount + 1) / 2; ++i) {
+                Bench::createMovingEntity(*world, rng, extent);
+            }
+            state.ResumeTiming();
+        }
+
+        state.SetItemsProcessed(state.iterations() * ((entityCount + 1) / 2));
+    }
+
+    // Querying and walking the matches when range(1) percent of the entities have a Velocity. The query is
+    // cached, so this measures the steady-state lookup plus touching every matched entity.
+    void BM_GetEntitiesWith(benchmark::State& state)
+    {
+        int entityCount = static_cast<int>(state.range(0));
+        int matchPercent = static_cast<int>(state.range(1));
+        auto world = Bench::makeWorld();
+        float extent = Bench::getSceneExtent(entityCount);
+        std::mt19937 rng(Bench::SEED);
+
+        for (int i = 0; i < entityCount; ++i) {
+            if (i % 100 < matchPercent) {
+                Bench::createMovingEntity(*world, rng, extent);
+            } else {
+                Entity& entity = world->EntityManager.CreateEntity(*world);
+                entity.addComponent<Transform>().position = Bench::randomPoint(rng, extent);
+                entity.addComponent<HealthComponent>();
+            }
+        }
+
+        std::size_t matched = 0;
+        for (auto _ : state) {
+            auto entities = world->EntityManager.GetEntitiesWith<Transform, Velocity>();
+            float sum = 0.0f;
+            for (Entity* entity : entities) {
+                sum += entity->getComponent<Velocity>().Speed;
+            }
+            benchmark::DoNotOptimize(sum);
+            matched = entities.size();
+        }
+
+        state.counters["matched"] = static_cast<double>(matched);
+        state.SetItemsProcessed(state.iterations() * entityCount);
+    }
+
+    void BM_MovementSystemUpdate(benchmark::State& state)
+    {
+        int entityCount = static_cast<int>(state.range(0));
+        auto world = Bench::makeWorld();
+        float extent = Bench::getSceneExtent(entityCount);
+        std::mt19937 rng(Bench::SEED);
+
+        for (int i = 0; i < entityCount; ++i) {
+            Bench::createMovingEntity(*world, rng, extent);
+        }
+
+        for (auto _ : state) {
+            world->movementSystem.update(*world, 1.0f / 60.0f);
+        }
+
+        state.SetItemsProcessed(state.iterations() * entityCount);
+    }
+}
+
+BENCHMARK(BM_CreateEntity)
+    ->RangeMultiplier(10)->Range(Bench::MIN_ENTITIES, Bench::MAX_ENTITIES)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_CleanupInactiveEntities)
+    ->RangeMultiplier(10)->Range(Bench::MIN_ENTITIES, Bench::MAX_ENTITIES)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_GetEntitiesWith)
+    ->ArgsProduct({benchmark::CreateRange(Bench::MIN_ENTITIES, Bench::MAX_ENTITIES, 10), {1, 10, 50, 100}})
+    ->ArgNames({"entities", "matchPercent"})
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_MovementSystemUpdate)
+    ->RangeMultiplier(10)->Range(Bench::MIN_ENTITIES, Bench::MAX_ENTITIES)
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "../src/engine/core/model/ImportedModel.h"
+
+namespace {
+    const char* const ASSET_MODELS[] = {"duck.obj", "rifle.obj", "pine_tree_1.obj", "rock_cluster_5.obj"};
+
+    void BM_ParseOBJAsset(benchmark::State& state)
+    {
+        std::string path = std::string(DUCK_ASSETS_DIR) + "/models/" + ASSET_MODELS[state.range(0)];
+        state.SetLabel(ASSET_MODELS[state.range(0)]);
+
+        int vertexCount = 0;
+        for (auto _ : state) {
+            ModelImporter importer;
+            importer.parseOBJ(path);
+            vertexCount = importer.getNumVertices();
+        }
+
+        if (vertexCount == 0) {
+            state.SkipWithError(("could not load " + path).c_str());
+            return;
+        }
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(std::filesystem::file_size(path)));
+    }
+
+    // Writes a grid of range(0) triangles with positions, UVs and normals, the layout the exported assets use.
+    std::string writeGridOBJ(int triangleCount)
+    {
+        std::filesystem::path path = std::filesystem::temp_directory_path() /
+                                     ("duckengine_bench_" + std::to_string(triangleCount) + ".obj");
+        if (std::filesystem::exists(path)) return path.string();
+
+        std::ofstream file(path);
+        int quadsPerRow = 256;
+        int quadCount = (triangleCount + 1) / 2;
+        int rows = (quadCount + quadsPerRow - 1) / quadsPerRow;
+
+        for (int y = 0; y <= rows; ++y) {
+            for (int x = 0; x <= quadsPerRow; ++x) {
+                file << "v " << x * 0.1f << " " << y * 0.1f << " " << ((x * 7 + y * 3) % 11) * 0.01f << "\n";
+                file << "vt " << x / float(quadsPerRow) << " " << y / float(rows) << "\n";
+            }
+        }
+        file << "vn 0 0 1\n";
+
+        int stride = quadsPerRow + 1;
+        int written = 0;
+        for (int quad = 0; quad < quadCount && written < triangleCount; ++quad) {
+            int a = (quad / quadsPerRow) * stride + quad % quadsPerRow + 1;
+            int b = a + 1;
+            int c = a + stride;
+            int d = c + 1;
+            file << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 " << d << "/" << d << "/1\n";
+            if (++written < triangleCount) {
+                file << "f " << a << "/" << a << "/1 " << d << "/" << d << "/1 " << c << "/" << c << "/1\n";
+                ++written;
+            }
+        }
+
+        return path.string();
+    }
+
+    void BM_ParseOBJGenerated(benchmark::State& state)
+    {
+        int triangleCount = static_cast<int>(state.range(0));
+        std::string path = writeGridOBJ(triangleCount);
+
+        for (auto _ : state) {
+            ModelImporter importer;
+            importer.parseOBJ(path);
+            benchmark::DoNotOptimize(importer.getNumVertices());
+        }
+
+        state.SetItemsProcessed(state.iterations() * triangleCount);
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(std::filesystem::file_size(path)));
+    }
+}
+
+BENCHMARK(BM_ParseOBJAsset)
+    ->DenseRange(0, std::size(ASSET_MODELS) - 1)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_ParseOBJGenerated)
+    ->RangeMultiplier(10)->Range(1'000, 100'000)
+    ->Unit(benchmark::kMillisecond);
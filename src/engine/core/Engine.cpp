@@ -1,4 +1,6 @@
 #include "Engine.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include "../src/engine/ecs/Component.h"
 #include "../src/engine/ecs/system/DebugRenderSystem.h"
@@ -9,43 +11,45 @@
 #include "../game/ecs/system/GameStateSystem.h"
 #include "../game/EventQueue.h"
 #include "../ecs/components/DuckComponent.h"
+#include "../debug/Profiler.h"
+#include "../renderer/Frustum.h"
 
 struct StaticMeshComponent;
 
 // Global instances since we cannot modify Engine.h easily
 
-bool Engine::initialize(int width, int height, bool fullscreen) {
-    screenWidth = width;
-    screenHeight = height;
-
-    // Initialize GLFW
-    if (!glfwInit()) {
-        std::cerr << "Failed to initialize GLFW" << std::endl;
-        return false;
+namespace {
+    // Mesa reads these when a display connection is opened, so they must be set before glfwInit.
+    void requestSoftwareGL() {
+#ifdef __linux__
+        setenv("LIBGL_ALWAYS_SOFTWARE", "1", 1);
+        setenv("GALLIUM_DRIVER", "llvmpipe", 0);
+#endif
     }
 
-    // OpenGL 3.3 Core check
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-    GLFWmonitor* monitor = nullptr;
-    if (fullscreen) {
-        monitor = glfwGetPrimaryMonitor();
-        const GLFWvidmode* mode = glfwGetVideoMode(monitor);
-        screenWidth = mode->width;
-        screenHeight = mode->height;
-
-        glfwWindowHint(GLFW_RED_BITS, mode->redBits);
-        glfwWindowHint(GLFW_GREEN_BITS, mode->greenBits);
-        glfwWindowHint(GLFW_BLUE_BITS, mode->blueBits);
-        glfwWindowHint(GLFW_REFRESH_RATE, mode->refreshRate);
+    // Offscreen runs need no display server: GLFW 3.4's null platform renders into an EGL pbuffer instead.
+    // GLFW 3.3 has no platform hint; there, and when GLFW was built without the null platform, an offscreen
+    // run opens a hidden window on the default platform.
+    bool initGLFW(bool bOffscreen) {
+#if GLFW_VERSION_MAJOR > 3 || GLFW_VERSION_MINOR >= 4
+        if (bOffscreen) {
+            glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+            if (glfwInit()) return true;
+        }
+        // Hints outlive glfwTerminate, so reset it for the software GL retry too
+        glfwInitHint(GLFW_PLATFORM, GLFW_ANY_PLATFORM);
+#endif
+        return glfwInit();
     }
+}
 
-    window = glfwCreateWindow(screenWidth, screenHeight, "Game", monitor, nullptr);
-    if (!window) {
-        std::cerr << "Failed to create GLFW window" << std::endl;
-        glfwTerminate();
+bool Engine::initialize(int width, int height, bool fullscreen, bool offscreen, bool softwareGL, bool compactGBuffer) {
+    screenWidth = width;
+    screenHeight = height;
+    bOffscreen = offscreen;
+    DUCK_PROFILE_THREAD("Main");
+
+    if (!createWindow(fullscreen && !offscreen, softwareGL)) {
         return false;
     }
 
@@ -94,7 +98,7 @@ bool Engine::initialize(int width, int height, bool fullscreen) {
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 
     updateLoadingScreen();
-    gBuffer.initialize(screenWidth, screenHeight);
+    gBuffer.initialize(screenWidth, screenHeight, compactGBuffer ? GBufferLayout::COMPACT : GBufferLayout::STANDARD);
     setupQuad();
 
     updateLoadingScreen();
@@ -112,6 +116,9 @@ bool Engine::initialize(int width, int height, bool fullscreen) {
         std::cerr << "Failed to load basic shaders" << std::endl;
         return false;
     }
+    // Fixed for the lifetime of the G-buffer, so set once
+    basicShader.use();
+    basicShader.setBool("compactGBuffer", gBuffer.isCompact());
 
     updateLoadingScreen();
     if (!lightingShader.loadFromFiles("../assets/shaders/light.vert", "../assets/shaders/light.frag")) {
@@ -189,6 +196,24 @@ bool Engine::initialize(int width, int height, bool fullscreen) {
     // Initialize Debug Renderer
     debugSystem.init();
 
+    // Not fatal: without timer queries the GPU overlay just stays empty
+    gpuTimer.initialize();
+
+    if (!frameUniforms.initialize()) {
+        std::cerr << "Failed to create the frame uniform buffer" << std::endl;
+        return false;
+    }
+
+    if (!lightGrid.initialize()) {
+        std::cerr << "Failed to create the light grid" << std::endl;
+        return false;
+    }
+
+    if (!lightVolumes.initialize(gBuffer)) {
+        std::cerr << "Failed to initialize light volumes" << std::endl;
+        return false;
+    }
+
     createFloor();
 
     updateLoadingScreen();
@@ -197,6 +222,7 @@ bool Engine::initialize(int width, int height, bool fullscreen) {
     camera.updateAspectRatio(screenWidth, screenHeight);
     camera.position = glm::vec3(5.0f, 5.0f, 5.0f);
 
+    std::cout << "Frustum cull kernel: " << getFrustumCullKernelName() << std::endl;
     std::cout << "Engine initialized successfully!" << std::endl;
 
     updateLoadingScreen();
@@ -213,13 +239,71 @@ bool Engine::initialize(int width, int height, bool fullscreen) {
     AudioManager::Get().Init();
     stateManager.setWorldContext(&world);
 
+    // Nobody can click through the menu of an offscreen run, so it goes straight into the game.
+    if (bOffscreen) {
+        stateManager.setState(GameState::PLAYING);
+    }
+
     return true;
 }
 
-void Engine::run() {
+bool Engine::createWindow(bool fullscreen, bool softwareGL) {
+    if (softwareGL) {
+        requestSoftwareGL();
+    }
+
+    // Initialize GLFW
+    if (!initGLFW(bOffscreen)) {
+        std::cerr << "Failed to initialize GLFW" << std::endl;
+        return false;
+    }
+
+    // OpenGL 3.3 Core check
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+    if (bOffscreen) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+    }
+
+    GLFWmonitor* monitor = nullptr;
+    if (fullscreen) {
+        monitor = glfwGetPrimaryMonitor();
+        const GLFWvidmode* mode = glfwGetVideoMode(monitor);
+        screenWidth = mode->width;
+        screenHeight = mode->height;
+
+        glfwWindowHint(GLFW_RED_BITS, mode->redBits);
+        glfwWindowHint(GLFW_GREEN_BITS, mode->greenBits);
+        glfwWindowHint(GLFW_BLUE_BITS, mode->blueBits);
+        glfwWindowHint(GLFW_REFRESH_RATE, mode->refreshRate);
+    }
+
+    window = glfwCreateWindow(screenWidth, screenHeight, "Game", monitor, nullptr);
+    if (window) {
+        return true;
+    }
+
+    glfwTerminate();
+
+    // No usable hardware driver (a build server, a container): retry once on Mesa's llvmpipe rasterizer.
+    if (!softwareGL) {
+        std::cerr << "Failed to create GLFW window, retrying with software GL" << std::endl;
+        return createWindow(fullscreen, true);
+    }
+
+    std::cerr << "Failed to create GLFW window" << std::endl;
+    return false;
+}
+
+void Engine::run(int maxFrames) {
     float lastFrame = 0.0f;
+    int frame = 0;
 
-    while (!glfwWindowShouldClose(window)) {
+    while (!glfwWindowShouldClose(window) && (maxFrames <= 0 || frame++ < maxFrames)) {
+        DUCK_PROFILE_SCOPE("Frame");
         float currentFrame = glfwGetTime();
         float deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
@@ -255,6 +339,11 @@ void Engine::processInput() {
         stateManager.togglePause();
     }
 
+    // F9 writes the profiler's recent zones as a Chrome trace (profiler builds only)
+    if (InputManager::isKeyPressed(GLFW_KEY_F9)) {
+        Profiler::writeChromeTrace("DuckEngineTrace.json");
+    }
+
     // Debug physics toggle
     static bool cKeyPressed = false;
     if (InputManager::isKeyDown(GLFW_KEY_C) && !cKeyPressed) {
@@ -264,9 +353,30 @@ void Engine::processInput() {
     if (!InputManager::isKeyDown(GLFW_KEY_C)) {
         cKeyPressed = false;
     }
+
+    // GPU pass timings overlay toggle
+    static bool gKeyPressed = false;
+    if (InputManager::isKeyDown(GLFW_KEY_G) && !gKeyPressed) {
+        bGpuTimings = !bGpuTimings;
+        gKeyPressed = true;
+    }
+    if (!InputManager::isKeyDown(GLFW_KEY_G)) {
+        gKeyPressed = false;
+    }
+
+    // Point light path toggle (clustered loop / light volumes), to compare in the GPU overlay
+    static bool lKeyPressed = false;
+    if (InputManager::isKeyDown(GLFW_KEY_L) && !lKeyPressed) {
+        bLightVolumes = !bLightVolumes;
+        lKeyPressed = true;
+    }
+    if (!InputManager::isKeyDown(GLFW_KEY_L)) {
+        lKeyPressed = false;
+    }
 }
 
 void Engine::update(float deltaTime) {
+    DUCK_PROFILE_SCOPE("Engine::update");
     // Update input first
     InputManager::update();
 
@@ -276,8 +386,12 @@ void Engine::update(float deltaTime) {
     // Update UI
     uiManager.update(deltaTime);
 
+    // Collision events cover the steps of one frame
+    world.collisionSystem->clearEvents();
+
     if (stateManager.getCurrentState() == GameState::PLAYING) {
-        world.update(deltaTime);
+        simulationClock.advance(deltaTime, [this](float stepTime) { world.update(stepTime); });
+        world.interpolationAlpha = simulationClock.getAlpha();
     }
 
     // Process game events
@@ -285,13 +399,23 @@ void Engine::update(float deltaTime) {
 }
 
 void Engine::render() {
+    DUCK_PROFILE_SCOPE("Engine::render");
+    gpuTimer.beginFrame();
+
     //  ==== SHADOW PASS ====
+    gpuTimer.beginPass(GpuPass::SHADOW);
     // TODO: REMOVE - If final game does not have dynamic directional light
     shadowMap.updateLightSpaceTransform(world.lightManager);  // Synchronize with LightManager
 
+    // Shared by every pass below
+    frameUniforms.update(camera.getViewMatrix(), camera.getProjectionMatrix(), shadowMap.getLightSpaceMatrix(),
+                         camera.position);
+
     shadowMap.render(world);
+    gpuTimer.endPass();
 
     // ==== GEOMETRY PASS ====
+    gpuTimer.beginPass(GpuPass::GEOMETRY);
     gBuffer.bindForWriting();
 
     // Clear with color
@@ -300,8 +424,10 @@ void Engine::render() {
 
     renderFloor();
     renderEntities();
+    gpuTimer.endPass();
 
     // ==== LIGHTING PASS ====
+    gpuTimer.beginPass(GpuPass::LIGHTING);
     // Unbind GBuffer framebuffer and switch back to screen
     gBuffer.unbind();
     glViewport(0, 0, screenWidth, screenHeight);
@@ -310,13 +436,19 @@ void Engine::render() {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     glDisable(GL_DEPTH_TEST);
 
+    // With light volumes the fullscreen pass only does ambient and directional light, into an HDR target
+    if (bLightVolumes) {
+        lightVolumes.beginAccumulation(gBuffer);
+    }
+
     lightingShader.use();
-    lightingShader.setVec3("viewPos", camera.position);
 
-    // Get all lights and pass to shader
-    world.lightManager.uploadToShader(lightingShader);
+    // Re-uploads only the lights that changed
+    world.lightManager.upload();
 
     lightingShader.setInt("gPosition", 0);
+    lightingShader.setInt("gDepth", 0);
+    lightingShader.setBool("compactGBuffer", gBuffer.isCompact());
     lightingShader.setInt("gNormal", 1);
     lightingShader.setInt("gAlbedo", 2);
     lightingShader.setInt("gMetallicRoughness", 3);
@@ -335,11 +467,22 @@ void Engine::render() {
     glActiveTexture(GL_TEXTURE0 + 7);
     glBindTexture(GL_TEXTURE_2D, shadowMap.getDepthMap());
     lightingShader.setInt("shadowMap", 7);
-    lightingShader.setMat4("lightSpaceMatrix", shadowMap.getLightSpaceMatrix());
+
+    lightingShader.setBool("pointLightVolumes", bLightVolumes);
+    if (!bLightVolumes) {
+        // Each pixel only shades the point lights assigned to its cluster
+        lightGrid.build(world.lightManager, camera, screenWidth, screenHeight);
+        lightGrid.bind(lightingShader, 8, 9);
+    }
 
     // Render final quad
     renderQuad();
 
+    if (bLightVolumes) {
+        lightVolumes.renderPointLights(world.lightManager, camera);
+        lightVolumes.resolve();
+    }
+
     glEnable(GL_DEPTH_TEST);
     glBindFramebuffer(GL_READ_FRAMEBUFFER, gBuffer.getFramebuffer());  // GBuffer's framebuffer ID
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);  // Default framebuffer
@@ -349,21 +492,29 @@ void Engine::render() {
         GL_DEPTH_BUFFER_BIT, GL_NEAREST
     );
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    gpuTimer.endPass();
 
+    gpuTimer.beginPass(GpuPass::SKYBOX);
     glEnable(GL_DEPTH_TEST);
     skybox.render(camera, envCubemap);
+    gpuTimer.endPass();
 
     // ==== DEBUG RENDER PASS ====
     if (bPhysicsDebug) {
+        gpuTimer.beginPass(GpuPass::DEBUG);
         physicsDebugShader.use();
-        physicsDebugShader.setMat4("view", camera.getViewMatrix());
-        physicsDebugShader.setMat4("projection", camera.getProjectionMatrix());
-        debugSystem.render(world.EntityManager, physicsDebugShader);
+        debugSystem.render(world.EntityManager, world.collisionSystem->getEvents(), physicsDebugShader);
+        gpuTimer.endPass();
     }
 
     // Handle UI last
+    gpuTimer.beginPass(GpuPass::UI);
     uiManager.render();
+    gpuTimer.endPass();
 
+    if (bGpuTimings) {
+        uiManager.renderGpuTimings(gpuTimer);
+    }
 }
 
 void Engine::framebufferSizeCallback(GLFWwindow *window, int width, int height) {
@@ -372,11 +523,19 @@ void Engine::framebufferSizeCallback(GLFWwindow *window, int width, int height)
 }
 
 void Engine::shutdown() {
+    Profiler::writeChromeTrace("DuckEngineTrace.json");
+
     glDeleteVertexArrays(1, &quadVAO);
     glDeleteBuffers(1, &quadVBO);
     cubeMaterial.unbind();
     uiManager.shutdown();
     debugSystem.cleanup();
+    renderingSystem.cleanup();
+    gpuTimer.cleanup();
+    frameUniforms.cleanup();
+    lightGrid.cleanup();
+    lightVolumes.cleanup();
+    world.lightManager.cleanup();
 
     glDeleteVertexArrays(1, &floorVAO);
     glDeleteBuffers(1, &floorVBO);
@@ -393,6 +552,7 @@ void Engine::onResize(int width, int height) {
 
     // Resize GBuffer
     gBuffer.resize(width, height);
+    lightVolumes.resize(gBuffer);
 
     // Update camera aspect ratio
     camera.updateAspectRatio(width, height);
@@ -594,14 +754,11 @@ void Engine::createFloor() {
 void Engine::renderFloor() {
     basicShader.use();
 
-    glm::mat4 view = camera.getViewMatrix();
-    glm::mat4 projection = camera.getProjectionMatrix();
     auto model = glm::mat4(1.0f);
     model = glm::translate(model, glm::vec3(0.0f, -1.0f, 0.0f));  // Lower the floor
 
+    basicShader.setBool("instanced", false);
     basicShader.setMat4("model", model);
-    basicShader.setMat4("view", view);
-    basicShader.setMat4("projection", projection);
 
     // Use same material or create a floor material
     floorMaterial.bind(basicShader);
@@ -10,9 +10,14 @@
 #include "../renderer/Cubemap.h"
 #include "../renderer/Skybox.h"
 #include "../renderer/ShadowMap.h"
+#include "../renderer/GpuTimer.h"
+#include "../renderer/FrameUniforms.h"
+#include "../renderer/light/LightGrid.h"
+#include "../renderer/light/LightVolumes.h"
 #include "managers/UIManager.h"
 #include "managers/UIStateManager.h"
 #include "../utils/LoadingScreen.h"
+#include "FixedStepClock.h"
 
 
 #include "../ecs/system/DebugRenderSystem.h"
@@ -22,8 +27,12 @@ class Engine {
 public:
     World world;
 
-    bool initialize(int width, int height, bool fullscreen);
-    void run();
+    // offscreen renders into a hidden surface without needing a display; softwareGL forces Mesa's llvmpipe,
+    // which is also tried automatically when no hardware context can be created.
+    bool initialize(int width, int height, bool fullscreen, bool offscreen = false, bool softwareGL = false,
+                    bool compactGBuffer = false);
+    // Runs until the window is closed, or for maxFrames frames when it is positive.
+    void run(int maxFrames = 0);
     void shutdown();
 
     void onResize(int width, int height);
@@ -46,9 +55,15 @@ public:
 
 private:
     GLFWwindow* window = nullptr;
+    bool bOffscreen = false;
     int screenWidth = 1920;
     int screenHeight = 1080;
 
+    // The world is simulated in fixed steps
+    FixedStepClock simulationClock;
+
+    bool createWindow(bool fullscreen, bool softwareGL);
+
     void processInput();
     void update(float deltaTime);
     void render();
@@ -81,6 +96,14 @@ private:
     Shader physicsDebugShader;
     bool bPhysicsDebug = false;
 
+    GpuTimer gpuTimer;
+    FrameUniforms frameUniforms;
+    LightGrid lightGrid;
+    LightVolumes lightVolumes;
+    bool bGpuTimings = false;
+    // Point lights drawn as stencil-tested light volumes instead of the clustered loop in light.frag
+    bool bLightVolumes = false;
+
     GLuint floorVAO, floorVBO;
 
     void createFloor();
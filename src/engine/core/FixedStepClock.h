@@ -0,0 +1,37 @@
+#pragma once
+#include <algorithm>
+
+// Turns variable frame times into fixed simulation steps; leftover frame time carries over to the next frame.
+// Engine and HeadlessEngine both step their world through one, so a headless run simulates what the game would.
+class FixedStepClock {
+public:
+    static constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
+    // Steps a single frame may run to catch up. Time beyond that is dropped, so a long hitch slows the
+    // game down for a moment instead of triggering ever longer catch-up frames.
+    static constexpr int MAX_STEPS_PER_FRAME = 5;
+
+    // Adds frameTime and calls step(FIXED_TIMESTEP) for every whole step it covers. Returns the steps run.
+    template <typename StepFunction>
+    int advance(float frameTime, StepFunction&& step)
+    {
+        accumulator += frameTime;
+
+        int steps = 0;
+        while (accumulator >= FIXED_TIMESTEP && steps < MAX_STEPS_PER_FRAME) {
+            step(FIXED_TIMESTEP);
+            accumulator -= FIXED_TIMESTEP;
+            ++steps;
+        }
+
+        if (steps == MAX_STEPS_PER_FRAME) {
+            accumulator = std::min(accumulator, FIXED_TIMESTEP);
+        }
+        return steps;
+    }
+
+    // How far the leftover time is into the next step, for interpolating between the last two steps.
+    float getAlpha() const { return accumulator / FIXED_TIMESTEP; }
+
+private:
+    float accumulator = 0.0f;
+};
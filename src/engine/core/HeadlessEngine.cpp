@@ -0,0 +1,80 @@
+#include "HeadlessEngine.h"
+#include <iostream>
+
+#include "../game/ecs/system/GameStateSystem.h"
+#include "../game/EventQueue.h"
+#include "../ecs/components/DuckComponent.h"
+#include "../debug/Profiler.h"
+
+bool HeadlessEngine::initialize()
+{
+    DUCK_PROFILE_THREAD("Main");
+    camera.position = glm::vec3(5.0f, 5.0f, 5.0f);
+
+    world.camera = &camera;
+    world.beginPlay();
+
+    std::cout << "Headless engine initialized (fixed step " << FixedStepClock::FIXED_TIMESTEP << "s)" << std::endl;
+    return world.getGameStateEntity() != nullptr;
+}
+
+void HeadlessEngine::tick(float frameTime)
+{
+    DUCK_PROFILE_SCOPE("HeadlessEngine::tick");
+    clockTime += frameTime;
+
+    // Collision events cover the steps of one frame
+    world.collisionSystem->clearEvents();
+
+    stepCount += simulationClock.advance(frameTime, [this](float stepTime) { world.update(stepTime); });
+    world.interpolationAlpha = simulationClock.getAlpha();
+
+    processGameEvents();
+}
+
+void HeadlessEngine::run(int frameCount, float frameTime)
+{
+    for (int frame = 0; frame < frameCount; ++frame) {
+        tick(frameTime);
+    }
+}
+
+void HeadlessEngine::shutdown()
+{
+    world.cleanUp();
+}
+
+void HeadlessEngine::processGameEvents()
+{
+    if (GameStateSystem::getEvents<GameOverEvent>().empty()) return;
+
+    const auto& event = GameStateSystem::getEvents<GameOverEvent>().front();
+    std::cout << "[HeadlessEngine] Game over in round " << event.roundReached
+              << " with score " << event.finalScore << std::endl;
+
+    restartGame();
+}
+
+void HeadlessEngine::restartGame()
+{
+    ++gamesPlayed;
+
+    Entity* gameState = world.getGameStateEntity();
+    if (gameState) {
+        GameStateSystem::resetGameState(*gameState);
+    }
+
+    // Same cleanup Engine does when restarting from the game-over screen
+    for (auto* entity : world.EntityManager.GetEntitiesWith<DuckComponent>()) {
+        if (entity && entity->getIsActive()) {
+            entity->destroy();
+        }
+    }
+    world.EntityManager.CleanupInactiveEntities();
+
+    if (world.duckSpawnerManager) {
+        world.duckSpawnerManager->Reset();
+    }
+
+    GameStateSystem::clearEvents();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "../ecs/World.h"
+#include "../renderer/Camera.h"
+#include "FixedStepClock.h"
+
+// Runs the simulation without a window, GL context or audio device. Time comes from a synthetic clock that
+// only moves when tick() is called, so a run is repeatable and as fast as the machine allows. The world is
+// stepped through a FixedStepClock, like Engine does it.
+class HeadlessEngine {
+public:
+    World world;
+
+    bool initialize();
+
+    // Advances the clock by frameTime and runs the fixed steps it covers.
+    void tick(float frameTime);
+
+    // Ticks frameCount frames of frameTime each.
+    void run(int frameCount, float frameTime);
+
+    void shutdown();
+
+    double getClockTime() const { return clockTime; }
+    long long getStepCount() const { return stepCount; }
+    int getGamesPlayed() const { return gamesPlayed; }
+
+private:
+    Camera camera;
+
+    double clockTime = 0.0;
+    FixedStepClock simulationClock;
+    long long stepCount = 0;
+    int gamesPlayed = 0;
+
+    // There is no game-over screen to wait on, so a lost game is cleaned up and restarted straight away.
+    void processGameEvents();
+    void restartGame();
+};
@@ -0,0 +1,152 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "../debug/Profiler.h"
+
+namespace {
+    // Identifies the pool and queue owned by the current thread, if it is a worker.
+    thread_local const JobSystem* currentJobSystem = nullptr;
+    thread_local std::size_t currentQueueIndex = 0;
+}
+
+unsigned int JobSystem::defaultWorkerCount()
+{
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+JobSystem::JobSystem(unsigned int workerCount)
+{
+    for (unsigned int i = 0; i <= workerCount; ++i) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        bRunning = false;
+    }
+    wakeCondition.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::submit(Job job, JobCounter& counter)
+{
+    counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+    WorkQueue& queue = *queues[getCurrentQueueIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(Task{std::move(job), &counter});
+    }
+    queuedTasks.fetch_add(1, std::memory_order_release);
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wakeCondition.notify_one();
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    std::size_t ownQueue = getCurrentQueueIndex();
+    while (!counter.isDone()) {
+        if (!tryRunTask(ownQueue)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool JobSystem::runPendingJob()
+{
+    return tryRunTask(getCurrentQueueIndex());
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t batchSize,
+                            const std::function<void(std::size_t, std::size_t)>& func)
+{
+    if (count == 0) return;
+    batchSize = std::max<std::size_t>(batchSize, 1);
+
+    // Nothing to spread across; skip the queue round-trip.
+    if (workers.empty() || count <= batchSize) {
+        func(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (std::size_t begin = 0; begin < count; begin += batchSize) {
+        std::size_t end = std::min(begin + batchSize, count);
+        submit([&func, begin, end]() { func(begin, end); }, counter);
+    }
+    wait(counter);
+}
+
+std::size_t JobSystem::getCurrentQueueIndex() const
+{
+    return currentJobSystem == this ? currentQueueIndex : 0;
+}
+
+bool JobSystem::tryRunTask(std::size_t ownQueue)
+{
+    if (queuedTasks.load(std::memory_order_acquire) == 0) return false;
+
+    Task task;
+    bool bFound = false;
+
+    // Newest job from our own queue first (cache-warm), then steal the oldest job from the others.
+    {
+        WorkQueue& queue = *queues[ownQueue];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            bFound = true;
+        }
+    }
+
+    for (std::size_t offset = 1; !bFound && offset < queues.size(); ++offset) {
+        WorkQueue& queue = *queues[(ownQueue + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            bFound = true;
+        }
+    }
+
+    if (!bFound) return false;
+
+    queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    task.job();
+    task.counter->pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::workerLoop(std::size_t ownQueue)
+{
+    currentJobSystem = this;
+    currentQueueIndex = ownQueue;
+    DUCK_PROFILE_THREAD("Worker " + std::to_string(ownQueue));
+
+    while (bRunning) {
+        if (tryRunTask(ownQueue)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeCondition.wait_for(lock, std::chrono::milliseconds(1), [this]() {
+            return !bRunning || queuedTasks.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
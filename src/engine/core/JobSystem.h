@@ -0,0 +1,77 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Tracks completion of a group of jobs submitted to a JobSystem.
+class JobCounter
+{
+public:
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{0};
+};
+
+// Work-stealing thread pool. Each worker owns a deque: it pops its own newest job first and steals the
+// oldest job of another queue when it runs dry. Threads that wait on a counter help run queued jobs,
+// so waiting from inside a job cannot deadlock the pool.
+class JobSystem
+{
+public:
+    using Job = std::function<void()>;
+
+    // Defaults to one worker per hardware thread, leaving one for the main thread.
+    explicit JobSystem(unsigned int workerCount = defaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void submit(Job job, JobCounter& counter);
+
+    // Blocks until every job tracked by the counter finished, running queued jobs meanwhile.
+    void wait(JobCounter& counter);
+
+    // Runs one queued job on the calling thread, if there is one. For threads waiting on something other than a
+    // counter that still want to help the pool along.
+    bool runPendingJob();
+
+    // Calls func(begin, end) over [0, count) in batches of at most batchSize, spread across the workers.
+    void parallelFor(std::size_t count, std::size_t batchSize, const std::function<void(std::size_t, std::size_t)>& func);
+
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+
+    static unsigned int defaultWorkerCount();
+
+private:
+    struct Task {
+        Job job;
+        JobCounter* counter = nullptr;
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Queue 0 is shared by non-worker threads; worker i owns queue i + 1.
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::atomic<bool> bRunning{true};
+    std::atomic<int> queuedTasks{0};
+    std::mutex sleepMutex;
+    std::condition_variable wakeCondition;
+
+    std::size_t getCurrentQueueIndex() const;
+    bool tryRunTask(std::size_t ownQueue);
+    void workerLoop(std::size_t ownQueue);
+};
@@ -1,4 +1,22 @@
 #include "AudioManager.h"
+#include <algorithm>
+
+#ifdef DUCK_HEADLESS
+
+// Headless builds have no audio device. Gameplay code keeps calling into the manager, so every call is a no-op
+// apart from remembering the master volume.
+void AudioManager::Init() {}
+void AudioManager::LoadSound(const std::string& name, const std::string& filepath) {}
+void AudioManager::PlaySound(const std::string& name, float volume) {}
+void AudioManager::PlayMusic(const std::string& name) {}
+void AudioManager::StopMusic() {}
+void AudioManager::CleanUp() {}
+
+void AudioManager::SetMasterVolume(float volume) {
+    masterVolume = std::clamp(volume, 0.0f, 1.0f);
+}
+
+#else
 
 #define DR_WAV_IMPLEMENTATION
 #include "../../dependencies/OpenAL/libs/Win64/dr_wav.h"
@@ -148,4 +166,6 @@ void AudioManager::CleanUp() {
     alcMakeContextCurrent(nullptr);
     alcDestroyContext(context);
     alcCloseDevice(device);
-}
\ No newline at end of file
+}
+
+#endif
@@ -69,6 +69,7 @@ void InputManager::update() {
 
     // Function keys
     keys[GLFW_KEY_F1] = (glfwGetKey(windowPtr, GLFW_KEY_F1) == GLFW_PRESS);
+    keys[GLFW_KEY_F9] = (glfwGetKey(windowPtr, GLFW_KEY_F9) == GLFW_PRESS);
     keys[GLFW_KEY_F11] = (glfwGetKey(windowPtr, GLFW_KEY_F11) == GLFW_PRESS);
 
     // Game control keys
@@ -81,6 +82,7 @@ void InputManager::update() {
     keys[GLFW_KEY_G] = (glfwGetKey(windowPtr, GLFW_KEY_G) == GLFW_PRESS);
     keys[GLFW_KEY_T] = (glfwGetKey(windowPtr, GLFW_KEY_T) == GLFW_PRESS);
     keys[GLFW_KEY_C] = (glfwGetKey(windowPtr, GLFW_KEY_C) == GLFW_PRESS);
+    keys[GLFW_KEY_L] = (glfwGetKey(windowPtr, GLFW_KEY_L) == GLFW_PRESS);
 
 
     // Number keys (for testing)
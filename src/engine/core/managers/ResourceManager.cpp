@@ -38,6 +38,10 @@ std::shared_ptr<Material> ResourceManager::GetMaterial(const std::string &materi
         return it->second;
     }
 
+#ifdef DUCK_HEADLESS
+    // Materials are only textures and shading parameters, which a headless build never uploads or draws.
+    return nullptr;
+#else
     std::cout << "[ResourceManager] Loading Material: " << materialName << std::endl;
 
     auto newMaterial = std::make_shared<Material>();
@@ -62,6 +66,7 @@ std::shared_ptr<Material> ResourceManager::GetMaterial(const std::string &materi
 
     MaterialCache[materialName] = newMaterial;
     return newMaterial;
+#endif
 }
 
 void ResourceManager::CollectGarbage()
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <algorithm>
+#include <cstdio>
 #include "UIManager.h"
 #include "UIStateManager.h"
 #include "InputManager.h"
@@ -7,6 +8,7 @@
 #include "../../ecs/Entity.h"
 #include "../../game/ecs/system/GameStateSystem.h"
 #include "../../game/ecs/components/GameRoundComponent.h"
+#include "../../debug/Profiler.h"
 
 
 UIManager::UIManager()
@@ -236,6 +238,56 @@ void UIManager::renderRound() {
     );
 }
 
+void UIManager::renderGpuTimings(const GpuTimer& gpuTimer) {
+    float scale = 18.0f / 30.0f;
+    float lineHeight = 24.0f;
+    int panelWidth = 560;
+    int panelHeight = static_cast<int>((GpuTimer::PASS_COUNT + 2) * lineHeight) + 20;
+
+    // Below the score panel
+    int panelX = 20;
+    int panelY = 120;
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_DEPTH_TEST);
+
+    renderQuad(
+        glm::vec2(panelX, panelY),
+        glm::vec2(panelWidth, panelHeight),
+        glm::vec4(0.0f, 0.0f, 0.0f, 0.6f)
+    );
+
+    // The font is monospaced, so padded columns line up
+    char line[64];
+    float textX = panelX + 10.0f;
+    float textY = panelY + 10.0f;
+    std::snprintf(line, sizeof(line), "%-9s%7s%7s%7s", "GPU ms", "min", "avg", "max");
+    font.renderText(line, textX, textY, scale, glm::vec4(0.7f, 0.7f, 0.7f, 1.0f), windowWidth, windowHeight);
+
+    float totalAvg = 0.0f;
+    for (int pass = 0; pass < GpuTimer::PASS_COUNT; ++pass) {
+        textY += lineHeight;
+        GpuTimer::PassStats stats = gpuTimer.getStats(static_cast<GpuPass>(pass));
+        const char* name = GpuTimer::getPassName(static_cast<GpuPass>(pass));
+
+        if (stats.samples == 0) {
+            std::snprintf(line, sizeof(line), "%-9s%7s%7s%7s", name, "-", "-", "-");
+        } else {
+            std::snprintf(line, sizeof(line), "%-9s%7.2f%7.2f%7.2f", name, stats.minMs, stats.avgMs, stats.maxMs);
+            totalAvg += stats.avgMs;
+        }
+        font.renderText(line, textX, textY, scale, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f), windowWidth, windowHeight);
+    }
+
+    textY += lineHeight;
+    std::snprintf(line, sizeof(line), "%-9s%14.2f", "Total", totalAvg);
+    font.renderText(line, textX, textY, scale, glm::vec4(1.0f, 0.84f, 0.0f, 1.0f), windowWidth, windowHeight);
+
+    glEnable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+}
+
 void UIManager::setupRenderingResources() {
     // Setup quad for rendering rectangles/buttons
     float quadVertices[] = {
@@ -373,6 +425,7 @@ bool UIManager::isMouseOverElement(const UIElement& element) {
 }
 
 void UIManager::render() {
+    DUCK_PROFILE_SCOPE("UIManager::render");
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     glDisable(GL_DEPTH_TEST);
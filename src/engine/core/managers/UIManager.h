@@ -1,6 +1,7 @@
 #pragma once
 #include "../../renderer/Shader.h"
 #include "../../renderer/BitmapFont.h"
+#include "../../renderer/GpuTimer.h"
 #include "../src/engine/renderer/Texture.h"
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
@@ -217,6 +218,9 @@ public:
 
     void renderRound();
 
+    // Debug overlay with the rolling min/avg/max GPU time of every render pass
+    void renderGpuTimings(const GpuTimer& gpuTimer);
+
 private:
     // OpenGL rendering setup
     Shader uiShader;
@@ -15,6 +15,7 @@ void StaticMesh::setupMesh(const std::vector<Vertex>& vertices, const std::vecto
     size = maxBounds - minBounds;
     center = (maxBounds + minBounds) / 2.0f;
 
+#ifndef DUCK_HEADLESS
     // Generate buffers
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &EBO);
@@ -49,6 +50,7 @@ void StaticMesh::setupMesh(const std::vector<Vertex>& vertices, const std::vecto
 
     // Unbind VAO
     glBindVertexArray(0);
+#endif
 }
 
 void StaticMesh::loadFromImportedModel(ImportedModel &model) {
@@ -86,6 +88,8 @@ void StaticMesh::loadFromImportedModel(ImportedModel &model) {
     setupMesh(vertices, indices);
 }
 
+// Headless builds only keep the bounds; no GPU buffers are ever created, so there is nothing to bind or free.
+#ifndef DUCK_HEADLESS
 void StaticMesh::bind() const {
     glBindVertexArray(VAO);
 }
@@ -95,6 +99,22 @@ void StaticMesh::draw() const {
     glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
 }
 
+void StaticMesh::bindInstanceData(GLuint instanceBuffer, std::size_t byteOffset) const {
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for (GLuint column = 0; column < 4; ++column) {
+        GLuint location = 3 + column;
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+                              (void*)(byteOffset + column * sizeof(glm::vec4)));
+        glVertexAttribDivisor(location, 1);
+    }
+}
+
+void StaticMesh::drawInstanced(GLsizei instanceCount) const {
+    if (VAO == 0 || instanceCount <= 0) return;
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, instanceCount);
+}
+
 void StaticMesh::cleanup() {
     if (VAO) glDeleteVertexArrays(1, &VAO);
     if (EBO) glDeleteBuffers(1, &EBO);
@@ -103,6 +123,13 @@ void StaticMesh::cleanup() {
         VBOs.clear();
     }
 }
+#else
+void StaticMesh::bind() const {}
+void StaticMesh::draw() const {}
+void StaticMesh::bindInstanceData(GLuint, std::size_t) const {}
+void StaticMesh::drawInstanced(GLsizei) const {}
+void StaticMesh::cleanup() {}
+#endif
 
 StaticMesh::~StaticMesh() {
     cleanup();
@@ -2,11 +2,11 @@
 #ifndef DUCKENGINE_STATICMESH_H
 #define DUCKENGINE_STATICMESH_H
 #include <glad/glad.h>
-#include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <vector>
 #include <string>
 #include "ImportedModel.h"
+#include "../../renderer/RenderResourceId.h"
 
 struct Vertex {
     glm::vec3 position;
@@ -24,6 +24,7 @@ class StaticMesh
     glm::vec3 maxBounds;
     glm::vec3 size;
     glm::vec3 center;
+    RenderResourceId<StaticMesh> renderId;
 
 public:
     StaticMesh()
@@ -36,10 +37,16 @@ public:
     void bind() const;
     void draw() const;
 
+    // Points the per-instance model matrix attribute (locations 3-6) at the glm::mat4s in instanceBuffer,
+    // starting at byteOffset. Call after bind().
+    void bindInstanceData(GLuint instanceBuffer, std::size_t byteOffset) const;
+    void drawInstanced(GLsizei instanceCount) const;
+
     glm::vec3 getMinBounds() const { return minBounds; }
     glm::vec3 getMaxBounds() const { return maxBounds; }
     glm::vec3 getSize() const { return size; }
     glm::vec3 getCenter() const { return center; }
+    std::uint32_t getRenderId() const { return renderId.get(); }
 
 private:
     void cleanup();
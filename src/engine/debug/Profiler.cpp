@@ -0,0 +1,211 @@
+#include "Profiler.h"
+
+#ifdef DUCK_PROFILER
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+    // On the GPU track, start is the timestamp the pass was submitted at and end its GPU duration in nanoseconds.
+    struct ZoneRecord {
+        const char* name;
+        std::uint64_t start;
+        std::uint64_t end;
+    };
+
+    // Written only by its thread. The registry owns it, so the zones of a finished thread can still be exported.
+    struct ThreadBuffer {
+        std::uint32_t threadIndex = 0;
+        std::string name;
+        bool bGpuTrack = false;
+        std::unique_ptr<ZoneRecord[]> zones = std::make_unique<ZoneRecord[]>(Profiler::ZONES_PER_THREAD);
+        // Zones ever recorded; the newest lives at (written - 1) % ZONES_PER_THREAD.
+        std::atomic<std::uint64_t> written{0};
+        // Zones before this one were cleared.
+        std::atomic<std::uint64_t> clearedUpTo{0};
+    };
+
+    using SteadyClock = std::chrono::steady_clock;
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        ThreadBuffer* gpuBuffer = nullptr;
+        // Node-based, so the strings never move.
+        std::unordered_set<std::string> internedNames;
+
+        // Timestamp and clock reading taken together at startup, to convert timestamps on export.
+        std::uint64_t originTimestamp = Profiler::readTimestamp();
+        SteadyClock::time_point originTime = SteadyClock::now();
+    };
+
+    Registry& getRegistry()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    thread_local ThreadBuffer* currentBuffer = nullptr;
+
+    // Caller holds the registry mutex.
+    ThreadBuffer* addBuffer(Registry& registry)
+    {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->threadIndex = static_cast<std::uint32_t>(registry.buffers.size());
+        buffer->name = "Thread " + std::to_string(buffer->threadIndex);
+        registry.buffers.push_back(std::move(buffer));
+        return registry.buffers.back().get();
+    }
+
+    ThreadBuffer& getThreadBuffer()
+    {
+        if (!currentBuffer) {
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            currentBuffer = addBuffer(registry);
+        }
+        return *currentBuffer;
+    }
+
+    ThreadBuffer& getGpuBuffer()
+    {
+        Registry& registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        if (!registry.gpuBuffer) {
+            registry.gpuBuffer = addBuffer(registry);
+            registry.gpuBuffer->name = "GPU";
+            registry.gpuBuffer->bGpuTrack = true;
+        }
+        return *registry.gpuBuffer;
+    }
+
+    void pushZone(ThreadBuffer& buffer, const ZoneRecord& zone)
+    {
+        std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+        buffer.zones[index % Profiler::ZONES_PER_THREAD] = zone;
+        buffer.written.store(index + 1, std::memory_order_release);
+    }
+
+    void writeJsonString(std::ostream& out, const std::string& text)
+    {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\';
+            if (static_cast<unsigned char>(c) >= 0x20) out << c;
+        }
+        out << '"';
+    }
+}
+
+void Profiler::record(const char* name, std::uint64_t start, std::uint64_t end)
+{
+    pushZone(getThreadBuffer(), {name, start, end});
+}
+
+void Profiler::recordGpuZone(const char* name, std::uint64_t submitTimestamp, std::uint64_t durationNanoseconds)
+{
+    static ThreadBuffer& gpuBuffer = getGpuBuffer();
+    pushZone(gpuBuffer, {name, submitTimestamp, durationNanoseconds});
+}
+
+void Profiler::setThreadName(const std::string& name)
+{
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(getRegistry().mutex);
+    buffer.name = name;
+}
+
+const char* Profiler::intern(const std::string& name)
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.internedNames.insert(name).first->c_str();
+}
+
+void Profiler::clear()
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& buffer : registry.buffers) {
+        buffer->clearedUpTo.store(buffer->written.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+bool Profiler::writeChromeTrace(const std::string& path)
+{
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "[Profiler] Failed to open " << path << std::endl;
+        return false;
+    }
+
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // Timestamps per microsecond, measured over everything since startup.
+    double elapsedMicroseconds = std::chrono::duration<double, std::micro>(SteadyClock::now() - registry.originTime).count();
+    double ticksPerMicrosecond = 1000.0;
+#if defined(__x86_64__) || defined(_M_X64)
+    if (elapsedMicroseconds > 0.0) {
+        ticksPerMicrosecond = static_cast<double>(readTimestamp() - registry.originTimestamp) / elapsedMicroseconds;
+    }
+#endif
+
+    auto toMicroseconds = [&](std::uint64_t timestamp) {
+        return static_cast<double>(static_cast<std::int64_t>(timestamp - registry.originTimestamp)) / ticksPerMicrosecond;
+    };
+
+    // Chrome trace times are in microseconds; three decimals keep nanosecond resolution.
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool bFirst = true;
+    std::size_t zoneCount = 0;
+
+    for (const auto& buffer : registry.buffers) {
+        if (!bFirst) file << ",\n";
+        bFirst = false;
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadIndex
+             << ",\"args\":{\"name\":";
+        writeJsonString(file, buffer->name);
+        file << "}}";
+
+        std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+        std::uint64_t first = written > ZONES_PER_THREAD ? written - ZONES_PER_THREAD : 0;
+        first = std::max(first, buffer->clearedUpTo.load(std::memory_order_relaxed));
+
+        // The GPU runs passes in order, so a pass starts when it was submitted or when the previous one ended.
+        double gpuBusyUntil = 0.0;
+        for (std::uint64_t i = first; i < written; ++i) {
+            const ZoneRecord& zone = buffer->zones[i % ZONES_PER_THREAD];
+            double start = toMicroseconds(zone.start);
+            double duration = 0.0;
+            if (buffer->bGpuTrack) {
+                start = std::max(start, gpuBusyUntil);
+                duration = static_cast<double>(zone.end) / 1000.0;
+                gpuBusyUntil = start + duration;
+            } else {
+                duration = toMicroseconds(zone.end) - start;
+            }
+
+            file << ",\n{\"name\":";
+            writeJsonString(file, zone.name);
+            file << ",\"cat\":\"" << (buffer->bGpuTrack ? "gpu" : "cpu") << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                 << buffer->threadIndex << ",\"ts\":" << start << ",\"dur\":" << duration << "}";
+        }
+        zoneCount += written - first;
+    }
+
+    file << "\n]}\n";
+    std::cout << "[Profiler] Wrote " << zoneCount << " zones to " << path << std::endl;
+    return static_cast<bool>(file);
+}
+
+#endif
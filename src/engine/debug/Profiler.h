@@ -0,0 +1,100 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Scoped-zone CPU profiler. DUCK_PROFILE_SCOPE("Name") records how long the enclosing scope took on the calling
+// thread; zones opened inside it nest under it in the trace. Every thread writes to its own ring buffer, so
+// recording takes no lock and only the newest ZONES_PER_THREAD zones of each thread are kept.
+//
+// Only compiled in when DUCK_PROFILER is defined (CMake option DUCK_PROFILER). Otherwise the macros expand to
+// nothing and the functions below are empty inlines, so instrumented code costs nothing in a shipping build.
+//
+// Zone names must outlive the profiler: string literals, or strings that are never freed or changed.
+//
+// Render passes timed on the GPU (GpuTimer) go to a separate "GPU" track via recordGpuZone, placed at the time the
+// pass was submitted so CPU and GPU work line up in the trace.
+
+#ifdef DUCK_PROFILER
+
+#if defined(__x86_64__) || defined(_M_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#else
+#include <chrono>
+#endif
+
+#define DUCK_PROFILE_CONCAT_INNER(a, b) a##b
+#define DUCK_PROFILE_CONCAT(a, b) DUCK_PROFILE_CONCAT_INNER(a, b)
+#define DUCK_PROFILE_SCOPE(name) Profiler::ScopedZone DUCK_PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define DUCK_PROFILE_THREAD(name) Profiler::setThreadName(name)
+
+class Profiler {
+public:
+    static constexpr std::size_t ZONES_PER_THREAD = 1 << 16;
+
+    class ScopedZone {
+    public:
+        explicit ScopedZone(const char* name) : name(name), start(readTimestamp()) {}
+        ~ScopedZone() { record(name, start, readTimestamp()); }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+    private:
+        const char* name;
+        std::uint64_t start;
+    };
+
+    // Names the calling thread's track in the trace; unnamed threads show up as "Thread <n>".
+    static void setThreadName(const std::string& name);
+
+    // Returns a copy of name that lives until exit, for zones named at runtime.
+    static const char* intern(const std::string& name);
+
+    // Writes every zone still in the ring buffers as Chrome trace JSON (chrome://tracing, Perfetto).
+    // Safe to call while other threads record, but their zones from the last moment may be missing.
+    static bool writeChromeTrace(const std::string& path);
+
+    // Records a pass the GPU spent durationNanoseconds on, submitted at submitTimestamp (a readTimestamp() value).
+    // Call from the render thread only.
+    static void recordGpuZone(const char* name, std::uint64_t submitTimestamp, std::uint64_t durationNanoseconds);
+
+    // Drops every recorded zone, e.g. to trace only what follows a loading screen.
+    static void clear();
+
+    // Raw timestamp: the TSC on x86-64, steady_clock nanoseconds elsewhere. Converted to time on export.
+    static std::uint64_t readTimestamp();
+
+private:
+    static void record(const char* name, std::uint64_t start, std::uint64_t end);
+};
+
+inline std::uint64_t Profiler::readTimestamp()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return __rdtsc();
+#else
+    auto sinceEpoch = std::chrono::steady_clock::now().time_since_epoch();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(sinceEpoch).count());
+#endif
+}
+
+#else
+
+#define DUCK_PROFILE_SCOPE(name)
+#define DUCK_PROFILE_THREAD(name)
+
+class Profiler {
+public:
+    static void setThreadName(const std::string&) {}
+    static const char* intern(const std::string&) { return ""; }
+    static bool writeChromeTrace(const std::string&) { return false; }
+    static void recordGpuZone(const char*, std::uint64_t, std::uint64_t) {}
+    static void clear() {}
+    static std::uint64_t readTimestamp() { return 0; }
+};
+
+#endif
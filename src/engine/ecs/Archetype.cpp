@@ -0,0 +1,136 @@
+#include "Archetype.h"
+#include "ChunkAllocator.h"
+
+#include <cassert>
+
+namespace {
+    std::size_t alignUp(std::size_t offset, std::size_t alignment) {
+        return (offset + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+Archetype::Archetype(const ComponentBitSet& signature, ChunkAllocator& allocator)
+    : signature(signature), allocator(allocator)
+{
+    std::size_t rowSize = sizeof(Entity*);
+    std::size_t worstCasePadding = 0;
+
+    for (ComponentTypeID typeID = 0; typeID < MAX_COMPONENTS; ++typeID) {
+        if (!signature[typeID]) continue;
+
+        const ComponentInfo& info = getComponentInfo(typeID);
+        componentTypes.push_back(typeID);
+        rowSize += info.size;
+        worstCasePadding += info.alignment;
+    }
+
+    chunkCapacity = static_cast<std::uint32_t>((CHUNK_SIZE - worstCasePadding) / rowSize);
+    if (chunkCapacity == 0) {
+        // A single row does not fit in a default chunk, size the chunk for exactly one row.
+        chunkCapacity = 1;
+        chunkBytes = rowSize + worstCasePadding;
+    }
+
+    // Entity pointers first, then one column per component in type ID order.
+    std::size_t offset = chunkCapacity * sizeof(Entity*);
+    for (ComponentTypeID typeID : componentTypes) {
+        const ComponentInfo& info = getComponentInfo(typeID);
+        offset = alignUp(offset, info.alignment);
+        columnOffsets[typeID] = offset;
+        offset += chunkCapacity * info.size;
+    }
+    assert(offset <= chunkBytes);
+}
+
+Archetype::~Archetype()
+{
+    for (auto& chunk : chunks) {
+        Entity** entities = getEntities(*chunk);
+        for (std::uint32_t row = 0; row < chunk->count; ++row) {
+            for (ComponentTypeID typeID : componentTypes) {
+                getComponentInfo(typeID).destroy(getComponent(*chunk, row, typeID));
+            }
+            entities[row] = nullptr;
+        }
+        freeChunk(chunk.get());
+    }
+}
+
+std::size_t Archetype::getEntityCount() const
+{
+    if (chunks.empty()) return 0;
+    return (chunks.size() - 1) * chunkCapacity + chunks.back()->count;
+}
+
+EntityLocation Archetype::allocateRow(Entity* entity)
+{
+    if (chunks.empty() || chunks.back()->count == chunkCapacity) {
+        allocateChunk();
+    }
+
+    ArchetypeChunk& chunk = *chunks.back();
+    std::uint32_t row = chunk.count++;
+    getEntities(chunk)[row] = entity;
+
+    markChanged();
+    return EntityLocation{this, &chunk, row};
+}
+
+Entity* Archetype::removeRow(const EntityLocation& location, bool destroyComponents)
+{
+    assert(location.archetype == this && location.chunk != nullptr);
+
+    ArchetypeChunk& chunk = *location.chunk;
+    std::uint32_t row = location.row;
+    markChanged();
+
+    if (destroyComponents) {
+        for (ComponentTypeID typeID : componentTypes) {
+            getComponentInfo(typeID).destroy(getComponent(chunk, row, typeID));
+        }
+    }
+
+    // Fill the hole with the very last row so every chunk except the last stays full.
+    ArchetypeChunk& lastChunk = *chunks.back();
+    std::uint32_t lastRow = lastChunk.count - 1;
+    Entity* movedEntity = nullptr;
+
+    if (&lastChunk != &chunk || lastRow != row) {
+        for (ComponentTypeID typeID : componentTypes) {
+            const ComponentInfo& info = getComponentInfo(typeID);
+            void* source = getComponent(lastChunk, lastRow, typeID);
+            info.moveConstruct(getComponent(chunk, row, typeID), source);
+            info.destroy(source);
+        }
+
+        movedEntity = getEntities(lastChunk)[lastRow];
+        getEntities(chunk)[row] = movedEntity;
+    }
+
+    getEntities(lastChunk)[lastRow] = nullptr;
+    --lastChunk.count;
+
+    if (lastChunk.count == 0) {
+        freeChunk(&lastChunk);
+        chunks.pop_back();
+    }
+
+    return movedEntity;
+}
+
+ArchetypeChunk* Archetype::allocateChunk()
+{
+    auto chunk = std::make_unique<ArchetypeChunk>();
+    chunk->data = allocator.allocate(chunkBytes);
+    chunk->capacity = chunkCapacity;
+
+    chunks.push_back(std::move(chunk));
+    return chunks.back().get();
+}
+
+void Archetype::freeChunk(ArchetypeChunk* chunk)
+{
+    allocator.free(chunk->data, chunkBytes);
+    chunk->data = nullptr;
+    chunk->count = 0;
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ComponentType.h"
+
+class Entity;
+class Archetype;
+class ChunkAllocator;
+
+// A fixed-size block of memory holding the components of up to `capacity` entities of one archetype.
+// Each component type is stored in its own contiguous column (SoA), next to a column of owning Entity pointers.
+struct ArchetypeChunk
+{
+    std::byte* data = nullptr;
+    std::uint32_t count = 0;
+    std::uint32_t capacity = 0;
+};
+
+// Where an entity's components currently live.
+struct EntityLocation
+{
+    Archetype* archetype = nullptr;
+    ArchetypeChunk* chunk = nullptr;
+    std::uint32_t row = 0;
+};
+
+// All entities sharing exactly the same ComponentBitSet. Rows are kept densely packed across chunks:
+// every chunk but the last is full, so systems can iterate the columns without holes.
+class Archetype
+{
+public:
+    // Target chunk size in bytes; archetypes with very large rows get bigger chunks.
+    static constexpr std::size_t CHUNK_SIZE = 16 * 1024;
+
+    Archetype(const ComponentBitSet& signature, ChunkAllocator& allocator);
+    ~Archetype();
+
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    const ComponentBitSet& getSignature() const { return signature; }
+    const std::vector<ComponentTypeID>& getComponentTypes() const { return componentTypes; }
+
+    bool hasComponent(ComponentTypeID typeID) const { return signature[typeID]; }
+    bool matches(const ComponentBitSet& required) const { return (signature & required) == required; }
+
+    std::size_t getChunkCount() const { return chunks.size(); }
+    ArchetypeChunk& getChunk(std::size_t index) { return *chunks[index]; }
+    std::uint32_t getChunkCapacity() const { return chunkCapacity; }
+    std::size_t getEntityCount() const;
+
+    // Bumped whenever rows are added or removed, or an entity in the archetype is destroyed. Queries compare
+    // it against the version they last saw to decide whether their cached entity list is stale.
+    std::uint64_t getVersion() const { return version; }
+    void markChanged() { ++version; }
+
+    Entity** getEntities(ArchetypeChunk& chunk) const
+    {
+        return reinterpret_cast<Entity**>(chunk.data);
+    }
+
+    void* getColumn(ArchetypeChunk& chunk, ComponentTypeID typeID) const
+    {
+        return chunk.data + columnOffsets[typeID];
+    }
+
+    template <typename T>
+    T* getColumn(ArchetypeChunk& chunk) const
+    {
+        return static_cast<T*>(getColumn(chunk, getComponentTypeID<T>()));
+    }
+
+    void* getComponent(ArchetypeChunk& chunk, std::uint32_t row, ComponentTypeID typeID) const
+    {
+        return chunk.data + columnOffsets[typeID] + row * getComponentInfo(typeID).size;
+    }
+
+    // Reserves a row at the end of the archetype for the entity. Component memory in the row is left
+    // uninitialized; the caller must construct every component of the signature into it.
+    EntityLocation allocateRow(Entity* entity);
+
+    // Removes a row, filling the hole with the archetype's last row. When destroyComponents is false the
+    // components in the row must already have been destroyed (or moved-from and destroyed) by the caller.
+    // Returns the entity that was moved into the freed row, or nullptr if none was.
+    Entity* removeRow(const EntityLocation& location, bool destroyComponents);
+
+    // Cached transitions to the archetype with one component added / removed.
+    std::array<Archetype*, MAX_COMPONENTS> addEdges{};
+    std::array<Archetype*, MAX_COMPONENTS> removeEdges{};
+
+private:
+    ComponentBitSet signature;
+    ChunkAllocator& allocator;
+    std::vector<ComponentTypeID> componentTypes;
+    std::array<std::size_t, MAX_COMPONENTS> columnOffsets{};
+    std::size_t chunkBytes = CHUNK_SIZE;
+    std::uint32_t chunkCapacity = 0;
+    std::uint64_t version = 0;
+
+    std::vector<std::unique_ptr<ArchetypeChunk>> chunks;
+
+    ArchetypeChunk* allocateChunk();
+    void freeChunk(ArchetypeChunk* chunk);
+};
@@ -0,0 +1,121 @@
+#include "ArchetypeStorage.h"
+#include "Entity.h"
+
+#include <algorithm>
+
+void* ArchetypeStorage::addComponent(Entity& entity, ComponentTypeID typeID)
+{
+    Archetype* current = entity.location.archetype;
+    Archetype* target = nullptr;
+
+    if (current) {
+        target = current->addEdges[typeID];
+        if (!target) {
+            ComponentBitSet signature = current->getSignature();
+            signature.set(typeID);
+            target = getOrCreateArchetype(signature);
+            current->addEdges[typeID] = target;
+            target->removeEdges[typeID] = current;
+        }
+    } else {
+        ComponentBitSet signature;
+        signature.set(typeID);
+        target = getOrCreateArchetype(signature);
+    }
+
+    moveEntity(entity, target);
+    trackConstructed(typeID);
+
+    const EntityLocation& location = entity.location;
+    return target->getComponent(*location.chunk, location.row, typeID);
+}
+
+void ArchetypeStorage::removeComponent(Entity& entity, ComponentTypeID typeID)
+{
+    Archetype* current = entity.location.archetype;
+    if (!current || !current->hasComponent(typeID)) return;
+
+    ComponentBitSet signature = current->getSignature();
+    signature.reset(typeID);
+
+    Archetype* target = nullptr;
+    if (signature.any()) {
+        target = current->removeEdges[typeID];
+        if (!target) {
+            target = getOrCreateArchetype(signature);
+            current->removeEdges[typeID] = target;
+            target->addEdges[typeID] = current;
+        }
+    }
+
+    moveEntity(entity, target);
+    trackDestroyed(typeID);
+}
+
+void ArchetypeStorage::removeEntity(Entity& entity)
+{
+    if (Archetype* current = entity.location.archetype) {
+        for (ComponentTypeID typeID : current->getComponentTypes()) {
+            trackDestroyed(typeID);
+        }
+    }
+
+    moveEntity(entity, nullptr);
+}
+
+Archetype* ArchetypeStorage::getOrCreateArchetype(const ComponentBitSet& signature)
+{
+    auto it = archetypeLookup.find(signature);
+    if (it != archetypeLookup.end()) {
+        return it->second;
+    }
+
+    archetypes.emplace_back(std::make_unique<Archetype>(signature, chunkAllocator));
+    Archetype* archetype = archetypes.back().get();
+    archetypeLookup.emplace(signature, archetype);
+    return archetype;
+}
+
+void ArchetypeStorage::moveEntity(Entity& entity, Archetype* target)
+{
+    EntityLocation source = entity.location;
+    EntityLocation destination{};
+
+    if (target) {
+        destination = target->allocateRow(&entity);
+    }
+
+    if (source.archetype) {
+        for (ComponentTypeID typeID : source.archetype->getComponentTypes()) {
+            const ComponentInfo& info = getComponentInfo(typeID);
+            void* component = source.archetype->getComponent(*source.chunk, source.row, typeID);
+
+            if (target && target->hasComponent(typeID)) {
+                info.moveConstruct(target->getComponent(*destination.chunk, destination.row, typeID), component);
+            }
+            info.destroy(component);
+        }
+
+        // Another entity may have been swapped into the row we just vacated.
+        if (Entity* movedEntity = source.archetype->removeRow(source, false)) {
+            movedEntity->location = source;
+        }
+    }
+
+    entity.location = destination;
+}
+
+void ArchetypeStorage::trackConstructed(ComponentTypeID typeID)
+{
+    ComponentMemoryStats& stats = componentStats[typeID];
+    stats.liveCount++;
+    stats.liveBytes += getComponentInfo(typeID).size;
+    stats.peakBytes = std::max(stats.peakBytes, stats.liveBytes);
+}
+
+void ArchetypeStorage::trackDestroyed(ComponentTypeID typeID)
+{
+    ComponentMemoryStats& stats = componentStats[typeID];
+    stats.liveCount--;
+    stats.liveBytes -= getComponentInfo(typeID).size;
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Archetype.h"
+#include "ChunkAllocator.h"
+
+class Entity;
+
+// Live/peak footprint of one component type across all archetypes. Moving a component between archetypes
+// does not count; only constructing it on an entity and finally destroying it does.
+struct ComponentMemoryStats
+{
+    std::size_t liveCount = 0;
+    std::size_t liveBytes = 0;
+    std::size_t peakBytes = 0;
+};
+
+// Owns every archetype and moves entities between them as components are added or removed.
+class ArchetypeStorage
+{
+public:
+    ArchetypeStorage() = default;
+
+    ArchetypeStorage(const ArchetypeStorage&) = delete;
+    ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+    // Moves the entity into the archetype that also contains typeID and returns the (uninitialized) memory
+    // the new component must be constructed into.
+    void* addComponent(Entity& entity, ComponentTypeID typeID);
+
+    // Destroys the component and moves the entity into the archetype without it.
+    void removeComponent(Entity& entity, ComponentTypeID typeID);
+
+    // Destroys all of the entity's components and releases its row.
+    void removeEntity(Entity& entity);
+
+    const std::vector<std::unique_ptr<Archetype>>& getArchetypes() const { return archetypes; }
+
+    const ComponentMemoryStats& getComponentStats(ComponentTypeID typeID) const { return componentStats[typeID]; }
+
+    template <typename T>
+    const ComponentMemoryStats& getComponentStats() const { return getComponentStats(getComponentTypeID<T>()); }
+
+    ChunkAllocator& getChunkAllocator() { return chunkAllocator; }
+
+private:
+    // Declared first so every archetype can return its chunks before the allocator goes away.
+    ChunkAllocator chunkAllocator;
+
+    std::array<ComponentMemoryStats, MAX_COMPONENTS> componentStats{};
+
+    std::unordered_map<ComponentBitSet, Archetype*> archetypeLookup;
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+
+    Archetype* getOrCreateArchetype(const ComponentBitSet& signature);
+
+    // Moves the entity's row into target (nullptr detaches it), migrating the components both archetypes share.
+    void moveEntity(Entity& entity, Archetype* target);
+
+    void trackConstructed(ComponentTypeID typeID);
+    void trackDestroyed(ComponentTypeID typeID);
+};
@@ -0,0 +1,51 @@
+#include "ChunkAllocator.h"
+
+#include <algorithm>
+#include <new>
+
+namespace {
+    constexpr std::align_val_t CHUNK_ALIGNMENT{64};
+}
+
+ChunkAllocator::~ChunkAllocator()
+{
+    releaseUnused();
+}
+
+std::byte* ChunkAllocator::allocate(std::size_t bytes)
+{
+    std::byte* block = nullptr;
+
+    auto it = freeLists.find(bytes);
+    if (it != freeLists.end() && !it->second.empty()) {
+        block = it->second.back();
+        it->second.pop_back();
+        cachedBytes -= bytes;
+    } else {
+        block = static_cast<std::byte*>(::operator new(bytes, CHUNK_ALIGNMENT));
+    }
+
+    usedBytes += bytes;
+    peakBytes = std::max(peakBytes, usedBytes + cachedBytes);
+    return block;
+}
+
+void ChunkAllocator::free(std::byte* block, std::size_t bytes)
+{
+    if (!block) return;
+
+    freeLists[bytes].push_back(block);
+    usedBytes -= bytes;
+    cachedBytes += bytes;
+}
+
+void ChunkAllocator::releaseUnused()
+{
+    for (auto& [bytes, blocks] : freeLists) {
+        for (std::byte* block : blocks) {
+            ::operator delete(block, CHUNK_ALIGNMENT);
+        }
+        cachedBytes -= bytes * blocks.size();
+        blocks.clear();
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+// Recycles archetype chunk memory. Freed blocks go on a free list per block size instead of back to the heap,
+// so archetypes that repeatedly empty and refill (ducks spawning and dying) stop allocating after warm-up.
+class ChunkAllocator
+{
+public:
+    ChunkAllocator() = default;
+    ~ChunkAllocator();
+
+    ChunkAllocator(const ChunkAllocator&) = delete;
+    ChunkAllocator& operator=(const ChunkAllocator&) = delete;
+
+    std::byte* allocate(std::size_t bytes);
+    void free(std::byte* block, std::size_t bytes);
+
+    // Returns every cached block to the heap.
+    void releaseUnused();
+
+    // Bytes currently handed out to archetypes.
+    std::size_t getUsedBytes() const { return usedBytes; }
+    // Bytes held on the free lists.
+    std::size_t getCachedBytes() const { return cachedBytes; }
+    std::size_t getPeakBytes() const { return peakBytes; }
+
+private:
+    std::unordered_map<std::size_t, std::vector<std::byte*>> freeLists;
+
+    std::size_t usedBytes = 0;
+    std::size_t cachedBytes = 0;
+    std::size_t peakBytes = 0;
+};
@@ -1,17 +1,78 @@
 #pragma once
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cassert>
 #include <cstddef>
+#include <new>
+#include <utility>
 
 using ComponentTypeID = std::size_t;
 
+//maximum amount of components an Entity can have.
+
+constexpr std::size_t MAX_COMPONENTS = 32;
+
+using ComponentBitSet = std::bitset<MAX_COMPONENTS>;
+
+// Type-erased description of a component type. Archetype chunks only know component types by ID, so they use
+// these function pointers to move components between chunks and to run their destructors.
+struct ComponentInfo
+{
+    std::size_t size = 0;
+    std::size_t alignment = 0;
+    void (*moveConstruct)(void* destination, void* source) = nullptr;
+    void (*destroy)(void* component) = nullptr;
+};
+
+inline std::array<ComponentInfo, MAX_COMPONENTS>& getComponentInfos()
+{
+    static std::array<ComponentInfo, MAX_COMPONENTS> infos{};
+    return infos;
+}
+
+inline const ComponentInfo& getComponentInfo(ComponentTypeID typeID)
+{
+    return getComponentInfos()[typeID];
+}
+
 inline ComponentTypeID getComponentTypeID()
 {
-    static ComponentTypeID id = 0;
+    // Atomic since a component type may first be used from a job running on a worker thread.
+    static std::atomic<ComponentTypeID> id{0};
     return id++;
 }
 
+template <typename T>
+ComponentTypeID registerComponentType()
+{
+    ComponentTypeID typeID = getComponentTypeID();
+    assert(typeID < MAX_COMPONENTS && "Too many component types, raise MAX_COMPONENTS");
+
+    ComponentInfo& info = getComponentInfos()[typeID];
+    info.size = sizeof(T);
+    info.alignment = alignof(T);
+    info.moveConstruct = [](void* destination, void* source) {
+        new (destination) T(std::move(*static_cast<T*>(source)));
+    };
+    info.destroy = [](void* component) {
+        static_cast<T*>(component)->~T();
+    };
+    return typeID;
+}
+
 template <typename T>
 ComponentTypeID getComponentTypeID()
 {
-    static ComponentTypeID TypeID = getComponentTypeID();
+    static ComponentTypeID TypeID = registerComponentType<T>();
     return TypeID;
-}
\ No newline at end of file
+}
+
+// Builds the signature bitset for a set of component types.
+template <typename... Components>
+ComponentBitSet getComponentSignature()
+{
+    ComponentBitSet signature;
+    (signature.set(getComponentTypeID<Components>()), ...);
+    return signature;
+}
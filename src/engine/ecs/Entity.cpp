@@ -1,16 +1,50 @@
 #include "Entity.h"
 #include "World.h"
+#include "ChunkAllocator.h"
+
+#include <mutex>
+
+namespace {
+    struct EntityMemoryPool {
+        std::mutex mutex;
+        ChunkAllocator allocator;
+    };
+
+    EntityMemoryPool& getEntityMemoryPool() {
+        static EntityMemoryPool pool;
+        return pool;
+    }
+}
+
+void* Entity::operator new(std::size_t size)
+{
+    EntityMemoryPool& pool = getEntityMemoryPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    return pool.allocator.allocate(size);
+}
+
+void Entity::operator delete(void* memory, std::size_t size)
+{
+    EntityMemoryPool& pool = getEntityMemoryPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    pool.allocator.free(static_cast<std::byte*>(memory), size);
+}
 
 Entity::~Entity() {
+    // Run the destructors of every component (releasing mesh/material references) and free the row.
+    if (storage) {
+        storage->removeEntity(*this);
+    }
+
+    // Frees the slot for reuse and invalidates any copies of this ID.
+    world->EntityManager.ReleaseEntityID(entityID);
 }
 
 Entity::Entity(World& InWorld) : world(nullptr)
 {
-    // Generate unique entity ID
-    static EntityID nextID = 1;
-    entityID = nextID++;
-
     world = &InWorld;
+    entityID = InWorld.EntityManager.AllocateEntityID(*this);
+    storage = &InWorld.EntityManager.GetArchetypeStorage();
 }
 
 void Entity::update(float deltaTime) {
@@ -26,5 +60,24 @@ bool Entity::getIsActive() const
 
 void Entity::destroy()
 {
+    if (!bIsActive) return;
     bIsActive = false;
-}
\ No newline at end of file
+
+    // Queued so cleanup only visits dead entities instead of scanning the whole list.
+    world->EntityManager.QueueForCleanup(entityID);
+
+    // Inactive entities are filtered out of cached queries, so they need to be rebuilt.
+    if (location.archetype) {
+        location.archetype->markChanged();
+    }
+}
+
+void* Entity::allocateComponent(ComponentTypeID typeID)
+{
+    return storage->addComponent(*this, typeID);
+}
+
+void Entity::releaseComponent(ComponentTypeID typeID)
+{
+    storage->removeComponent(*this, typeID);
+}
@@ -1,31 +1,47 @@
 #pragma once
-#include <array>
 #include <bitset>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 
 #include "ComponentType.h"
+#include "Archetype.h"
 
 
 class World;
+class ArchetypeStorage;
 
 
+// Generational handle: the low 32 bits index a slot in the EntityManager, the high 32 bits hold the slot's
+// generation. Slots are reused once an entity is deleted, and the generation bump makes stale IDs resolve to
+// nullptr instead of to whichever entity took the slot over.
 using EntityID = std::uint64_t;
 constexpr EntityID INVALID_ENTITY_ID = 0;
 
-//maximum amount of components an Entity can have.
-
-constexpr std::size_t MAX_COMPONENTS = 32;
+inline EntityID makeEntityID(std::uint32_t index, std::uint32_t generation)
+{
+    return (static_cast<EntityID>(generation) << 32) | index;
+}
 
-using ComponentBitSet = std::bitset<MAX_COMPONENTS>;
+inline std::uint32_t getEntityIndex(EntityID id)
+{
+    return static_cast<std::uint32_t>(id);
+}
 
-// Each index is a Component , The index corresponds to the ComponentTypeID.
-using ComponentArray = std::array<void*, MAX_COMPONENTS>;
+inline std::uint32_t getEntityGeneration(EntityID id)
+{
+    return static_cast<std::uint32_t>(id >> 32);
+}
 
+// Components are not owned by the Entity itself; they live in the archetype chunk matching the entity's
+// ComponentBitSet. Adding or removing a component moves the entity to another archetype, so references
+// returned by addComponent/getComponent are only valid until the next add/remove on the same entity.
 class Entity
 {
-ComponentArray ComponentArray{};
-ComponentBitSet ComponentBitSet{};
+friend class ArchetypeStorage;
+
+EntityLocation location{};
+ArchetypeStorage* storage = nullptr;
 
 EntityID entityID = INVALID_ENTITY_ID;
 
@@ -37,6 +53,14 @@ public:
 
     Entity(World& InWorld);
 
+    Entity(const Entity&) = delete;
+    Entity& operator=(const Entity&) = delete;
+
+    // Entities are allocated from a pool with a free list per object size, so ducks that die and respawn every
+    // round reuse the same memory instead of going back to the heap.
+    static void* operator new(std::size_t size);
+    static void operator delete(void* memory, std::size_t size);
+
     EntityID getID() const { return entityID; }
 
     virtual void update(float deltaTime);
@@ -47,32 +71,57 @@ public:
 
     void destroy();
 
+    const EntityLocation& getLocation() const { return location; }
+
+    ComponentBitSet getSignature() const
+    {
+        return location.archetype ? location.archetype->getSignature() : ComponentBitSet{};
+    }
+
     template<typename T>
     bool hasComponent()
     {
-        return ComponentArray[getComponentTypeID<T>()];
+        return location.archetype && location.archetype->hasComponent(getComponentTypeID<T>());
     }
 
     template<typename T, typename... nArgs>
     T& addComponent(nArgs&&... args)
     {
         // Implements Perfect Fowarding; everything is not treated as a l-value. More efficient with moves and temporaries.
-        T* component(new T(std::forward<nArgs>(args)...));
-
-        ComponentArray[getComponentTypeID<T>()] = component;
-        ComponentBitSet[getComponentTypeID<T>()] = true;
-
-        return *component;
+        // The value is built before the entity migrates, since args may reference this entity's current components.
+        T component(std::forward<nArgs>(args)...);
+
+        if (hasComponent<T>()) {
+            // Replacing: the old component is destroyed (releasing what it holds) before the new one takes its slot.
+            T* existing = &getComponent<T>();
+            existing->~T();
+            return *new (existing) T(std::move(component));
+        }
+
+        void* memory = allocateComponent(getComponentTypeID<T>());
+        return *new (memory) T(std::move(component));
     }
 
     template<typename T>
     T& getComponent() {
-        auto ptr(ComponentArray[getComponentTypeID<T>()]);
+        auto ptr(location.archetype->getComponent(*location.chunk, location.row, getComponentTypeID<T>()));
         return *static_cast<T*>(ptr);
     }
 
+    template<typename T>
+    void removeComponent() {
+        releaseComponent(getComponentTypeID<T>());
+    }
+
+    // Deactivating a component removes it from the entity's signature, which in archetype storage means
+    // destroying it and moving the entity to the archetype without it.
     template<typename T>
     void deactivateComponent() {
-        ComponentBitSet[getComponentTypeID<T>()] = false;
+        removeComponent<T>();
     }
-};
\ No newline at end of file
+
+private:
+    void* allocateComponent(ComponentTypeID typeID);
+
+    void releaseComponent(ComponentTypeID typeID);
+};
@@ -0,0 +1,39 @@
+#include "EntityCommandBuffer.h"
+#include "World.h"
+
+void EntityCommandBuffer::createEntity(EntityInit init)
+{
+    commands.push_back({CommandType::Create, INVALID_ENTITY_ID, std::move(init)});
+}
+
+void EntityCommandBuffer::destroyEntity(EntityID id)
+{
+    commands.push_back({CommandType::Destroy, id, {}});
+}
+
+void EntityCommandBuffer::playback(World& world)
+{
+    // Swapped out first: an init callback may record more commands into this buffer.
+    std::swap(commands, playbackCommands);
+
+    for (Command& command : playbackCommands) {
+        if (command.type == CommandType::Create) {
+            Entity& entity = world.EntityManager.CreateEntity(world);
+            if (command.apply) {
+                command.apply(entity);
+            }
+            continue;
+        }
+
+        Entity* entity = world.EntityManager.GetEntityByID(command.target);
+        if (!entity || !entity->getIsActive()) continue;
+
+        if (command.type == CommandType::Destroy) {
+            entity->destroy();
+        } else {
+            command.apply(*entity);
+        }
+    }
+
+    playbackCommands.clear();
+}
@@ -0,0 +1,83 @@
+#pragma once
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "Entity.h"
+
+class World;
+
+// Records structural changes (create/destroy entities, add/remove components) so systems can request them
+// while iterating chunks or query spans, and applies them later at a sync point where nothing is iterating.
+// Also takes component edits, so a system that rarely changes a widely read component doesn't have to declare
+// a write to it. Targets are stored as EntityIDs, so commands for entities deleted in the meantime are skipped.
+class EntityCommandBuffer
+{
+public:
+    using EntityInit = std::function<void(Entity&)>;
+
+    // Creates a plain entity at playback and hands it to init, which can add its components.
+    void createEntity(EntityInit init = {});
+
+    void destroyEntity(EntityID id);
+
+    template <typename T, typename... Args>
+    void addComponent(EntityID id, Args&&... args);
+
+    template <typename T>
+    void removeComponent(EntityID id);
+
+    // Calls edit(T&) at playback if the entity still has a T.
+    template <typename T, typename Edit>
+    void editComponent(EntityID id, Edit edit);
+
+    bool isEmpty() const { return commands.empty(); }
+
+    // Applies the recorded commands in order and clears the buffer. Commands recorded while playing back
+    // are kept for the next playback.
+    void playback(World& world);
+
+private:
+    enum class CommandType { Create, Destroy, Edit };
+
+    struct Command {
+        CommandType type;
+        EntityID target = INVALID_ENTITY_ID;
+        EntityInit apply;
+    };
+
+    std::vector<Command> commands;
+    std::vector<Command> playbackCommands;
+};
+
+template <typename T, typename... Args>
+void EntityCommandBuffer::addComponent(EntityID id, Args&&... args)
+{
+    // The component is built now, so args may safely reference data that changes before playback.
+    commands.push_back({CommandType::Edit, id,
+        [component = T(std::forward<Args>(args)...)](Entity& entity) mutable {
+            entity.addComponent<T>(std::move(component));
+        }});
+}
+
+template <typename T>
+void EntityCommandBuffer::removeComponent(EntityID id)
+{
+    commands.push_back({CommandType::Edit, id,
+        [](Entity& entity) {
+            if (entity.hasComponent<T>()) {
+                entity.removeComponent<T>();
+            }
+        }});
+}
+
+template <typename T, typename Edit>
+void EntityCommandBuffer::editComponent(EntityID id, Edit edit)
+{
+    commands.push_back({CommandType::Edit, id,
+        [edit = std::move(edit)](Entity& entity) mutable {
+            if (entity.hasComponent<T>()) {
+                edit(entity.getComponent<T>());
+            }
+        }});
+}
@@ -0,0 +1,60 @@
+#include "EntityQuery.h"
+#include "ArchetypeStorage.h"
+#include "Entity.h"
+
+EntityQuery::EntityQuery(const ComponentBitSet& signature) : signature(signature)
+{
+}
+
+void EntityQuery::updateArchetypes(const ArchetypeStorage& storage)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto& allArchetypes = storage.getArchetypes();
+
+    for (; archetypesSeen < allArchetypes.size(); ++archetypesSeen) {
+        Archetype* archetype = allArchetypes[archetypesSeen].get();
+        if (archetype->matches(signature)) {
+            archetypes.push_back(archetype);
+            // Guarantees the first getEntities() after this picks the archetype up.
+            seenVersions.push_back(archetype->getVersion() - 1);
+        }
+    }
+}
+
+std::span<Entity* const> EntityQuery::getEntities()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    bool bStale = false;
+    for (std::size_t i = 0; i < archetypes.size(); ++i) {
+        if (archetypes[i]->getVersion() != seenVersions[i]) {
+            seenVersions[i] = archetypes[i]->getVersion();
+            bStale = true;
+        }
+    }
+
+    if (bStale) {
+        rebuildEntities();
+    }
+
+    return entities;
+}
+
+void EntityQuery::rebuildEntities()
+{
+    // clear() keeps the capacity, so steady-state rebuilds do not allocate.
+    entities.clear();
+
+    for (Archetype* archetype : archetypes) {
+        for (std::size_t i = 0; i < archetype->getChunkCount(); ++i) {
+            ArchetypeChunk& chunk = archetype->getChunk(i);
+            Entity** chunkEntities = archetype->getEntities(chunk);
+
+            for (std::uint32_t row = 0; row < chunk.count; ++row) {
+                if (chunkEntities[row]->getIsActive()) {
+                    entities.push_back(chunkEntities[row]);
+                }
+            }
+        }
+    }
+}
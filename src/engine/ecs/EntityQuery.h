@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "ComponentType.h"
+
+class Archetype;
+class ArchetypeStorage;
+class Entity;
+
+// Persistent view of all active entities whose signature contains a given set of components.
+// Matching archetypes are appended as they are created, and the cached entity list is only rebuilt when
+// one of those archetypes has changed since the last call, so steady-state lookups do not scan or allocate.
+class EntityQuery
+{
+public:
+    explicit EntityQuery(const ComponentBitSet& signature);
+
+    const ComponentBitSet& getSignature() const { return signature; }
+
+    // Picks up archetypes created since the last refresh.
+    void updateArchetypes(const ArchetypeStorage& storage);
+
+    const std::vector<Archetype*>& getArchetypes() const { return archetypes; }
+
+    // Active matching entities. The span stays valid until the next getEntities() call on this query.
+    std::span<Entity* const> getEntities();
+
+private:
+    ComponentBitSet signature;
+
+    // Systems running in parallel may refresh the same query. Only structural changes can make a rebuild
+    // necessary, and the scheduler never runs those next to other systems, so returned spans stay stable.
+    std::mutex mutex;
+    std::size_t archetypesSeen = 0;
+
+    std::vector<Archetype*> archetypes;
+    std::vector<std::uint64_t> seenVersions;
+
+    std::vector<Entity*> entities;
+
+    void rebuildEntities();
+};
@@ -0,0 +1,101 @@
+#include "SystemScheduler.h"
+#include "../core/JobSystem.h"
+#include "../debug/Profiler.h"
+
+#include <mutex>
+#include <thread>
+
+bool SystemAccess::conflictsWith(const SystemAccess& other) const
+{
+    if (bStructural || other.bStructural) return true;
+
+    return (writes & (other.reads | other.writes)).any() ||
+           (other.writes & reads).any();
+}
+
+void SystemScheduler::addSystem(const std::string& name, const SystemAccess& access, UpdateFunction update)
+{
+    ScheduledSystem system{name, Profiler::intern(name), access, std::move(update), {}, 0};
+    std::size_t index = systems.size();
+
+    // Registration order is the serial order: a conflicting pair always runs earlier-registered first.
+    for (std::size_t i = 0; i < index; ++i) {
+        if (systems[i].access.conflictsWith(access)) {
+            systems[i].dependents.push_back(index);
+            system.dependencyCount++;
+        }
+    }
+
+    systems.push_back(std::move(system));
+    remainingDependencies = std::make_unique<std::atomic<int>[]>(systems.size());
+}
+
+void SystemScheduler::run(JobSystem& jobSystem, float deltaTime)
+{
+    if (systems.empty()) return;
+    DUCK_PROFILE_SCOPE("SystemScheduler::run");
+
+    for (std::size_t i = 0; i < systems.size(); ++i) {
+        remainingDependencies[i].store(systems[i].dependencyCount, std::memory_order_relaxed);
+    }
+
+    JobCounter counter;
+    std::atomic<std::size_t> remainingSystems{systems.size()};
+
+    // Ready main-thread systems wait here for the calling thread instead of going to the pool
+    std::mutex mainThreadMutex;
+    std::vector<std::size_t> mainThreadReady;
+
+    std::function<void(std::size_t)> schedule;
+
+    // Finishing a system releases its dependents; the last dependency to finish schedules the dependent.
+    // Dependents are scheduled before the system is counted as done, so the loop below cannot exit early.
+    auto runSystem = [&](std::size_t index) {
+        {
+            DUCK_PROFILE_SCOPE(systems[index].profileName);
+            systems[index].update(deltaTime);
+        }
+
+        for (std::size_t dependent : systems[index].dependents) {
+            if (remainingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                schedule(dependent);
+            }
+        }
+        remainingSystems.fetch_sub(1, std::memory_order_release);
+    };
+
+    schedule = [&](std::size_t index) {
+        if (systems[index].access.bMainThread) {
+            std::lock_guard<std::mutex> lock(mainThreadMutex);
+            mainThreadReady.push_back(index);
+            return;
+        }
+        jobSystem.submit([&runSystem, index]() { runSystem(index); }, counter);
+    };
+
+    for (std::size_t i = 0; i < systems.size(); ++i) {
+        if (systems[i].dependencyCount == 0) {
+            schedule(i);
+        }
+    }
+
+    while (remainingSystems.load(std::memory_order_acquire) > 0) {
+        std::size_t index = systems.size();
+        {
+            std::lock_guard<std::mutex> lock(mainThreadMutex);
+            if (!mainThreadReady.empty()) {
+                index = mainThreadReady.back();
+                mainThreadReady.pop_back();
+            }
+        }
+
+        if (index < systems.size()) {
+            runSystem(index);
+        } else if (!jobSystem.runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Every system is done, but the last jobs may still be returning from their lambdas
+    jobSystem.wait(counter);
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ComponentType.h"
+
+class JobSystem;
+
+// What a system touches. Two systems may run at the same time only if neither writes a component the other
+// reads or writes. Structural systems (creating/destroying entities, adding/removing components) change what
+// every query returns, so they never overlap with another system.
+//
+// Component access says nothing about side effects outside the ECS. A system that plays audio, emits game events,
+// loads resources or touches GL must be marked mainThread() so it always runs on the thread that called run().
+struct SystemAccess
+{
+    ComponentBitSet reads;
+    ComponentBitSet writes;
+    bool bStructural = false;
+    bool bMainThread = false;
+
+    template <typename... Components>
+    SystemAccess& read()
+    {
+        reads |= getComponentSignature<Components...>();
+        return *this;
+    }
+
+    template <typename... Components>
+    SystemAccess& write()
+    {
+        writes |= getComponentSignature<Components...>();
+        return *this;
+    }
+
+    SystemAccess& structural()
+    {
+        bStructural = true;
+        return *this;
+    }
+
+    SystemAccess& mainThread()
+    {
+        bMainThread = true;
+        return *this;
+    }
+
+    bool conflictsWith(const SystemAccess& other) const;
+};
+
+// Runs registered systems as a job graph: each system waits only on earlier-registered systems it conflicts
+// with, and everything else is free to run concurrently on the JobSystem's workers. Main-thread systems are run by
+// the calling thread, which helps with the workers' jobs while it waits for them to become ready.
+class SystemScheduler
+{
+public:
+    using UpdateFunction = std::function<void(float deltaTime)>;
+
+    void addSystem(const std::string& name, const SystemAccess& access, UpdateFunction update);
+
+    void run(JobSystem& jobSystem, float deltaTime);
+
+    std::size_t getSystemCount() const { return systems.size(); }
+
+private:
+    struct ScheduledSystem {
+        std::string name;
+        // Zone name for the profiler, which may outlive the scheduler.
+        const char* profileName;
+        SystemAccess access;
+        UpdateFunction update;
+        std::vector<std::size_t> dependents;
+        int dependencyCount = 0;
+    };
+
+    std::vector<ScheduledSystem> systems;
+    std::unique_ptr<std::atomic<int>[]> remainingDependencies;
+};
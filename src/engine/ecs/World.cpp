@@ -9,9 +9,9 @@
 #include "../game/ecs/components/GameRoundComponent.h"
 #include "../game/ecs/system/GameStateSystem.h"
 #include "../renderer/Camera.h"
-#include "GLFW/glfw3.h"
 #include "../ecs/system/CollisionSystem.h"
 #include "../game/EnvironmentGenerator.h"
+#include "../debug/Profiler.h"
 
 World::World()
 {
@@ -27,11 +27,51 @@ World::World()
     std::cout << "Point lights: " << lightManager.getPointLightCount() << std::endl;
 
     duckSpawnerManager = new DuckSpawnerManager(*this);
+
+    registerSystems();
+}
+
+void World::registerSystems()
+{
+    // Registration order is the order conflicting systems run in, matching the old serial update.
+    systemScheduler.addSystem("Movement",
+        SystemAccess().read<Velocity>().write<Transform>(),
+        [this](float deltaTime) { movementSystem.update(*this, deltaTime); });
+
+    // Refits the collision BVHs to this frame's positions, so it must come after Movement.
+    systemScheduler.addSystem("Collision",
+        SystemAccess().read<Transform, BoxCollider>(),
+        [this](float deltaTime) { collisionSystem->update(*this, deltaTime); });
+
+    // Bounds and Lifecycle queue their destroys on the command buffer, so they can run side by side.
+    // Bounds and DuckDeath go through GameStateSystem, which plays sounds and emits game events, so both stay
+    // on the main thread.
+    systemScheduler.addSystem("Bounds",
+        SystemAccess().read<Transform, BoundsComponent>().write<GameRoundComponent, DuckUIStateComponent>()
+                      .mainThread(),
+        [this](float deltaTime) { boundsSystem.update(*this, deltaTime); });
+
+    systemScheduler.addSystem("Lifecycle",
+        SystemAccess().read<Transform>().write<HealthComponent, Velocity>(),
+        [this](float deltaTime) { lifecycleSystem.update(*this, deltaTime); });
+
+    // DuckDeath and Gun set meshes and Transforms through the command buffer, so they don't wait on (or hold up)
+    // every system reading Transform.
+    systemScheduler.addSystem("DuckDeath",
+        SystemAccess().read<DuckComponent>()
+                      .write<HealthComponent>()
+                      .write<GameRoundComponent, ScoreComponent, DuckUIStateComponent>()
+                      .mainThread(),
+        [this](float deltaTime) { duckDeathSystem.update(*this, deltaTime); });
+
+    systemScheduler.addSystem("Gun",
+        SystemAccess().write<GunComponent>(),
+        [this](float deltaTime) { gunSystem.update(*this, *camera, deltaTime); });
 }
 
 void World::update(float deltaTime)
 {
-    float time = glfwGetTime();
+    DUCK_PROFILE_SCOPE("World::update");
 
     // --- RECOIL LOGIC ---
     // Recovery from recoil (Lerp back to 0), Higher recoverySpeed = snappier recovery
@@ -39,14 +79,22 @@ void World::update(float deltaTime)
     gunRecoilOffset = glm::mix(gunRecoilOffset, 0.0f, deltaTime * recoverySpeed);
     gunRecoilPitch  = glm::mix(gunRecoilPitch, 0.0f, deltaTime * recoverySpeed);
 
-    movementSystem.update(*this, deltaTime);
-    boundsSystem.update(*this, deltaTime);
-    lifecycleSystem.update(*this, deltaTime);
-    duckDeathSystem.update(*this, deltaTime);  // Handle duck-specific death visuals
-    gunSystem.update(*this, *camera, deltaTime);
+    // Movement, Bounds, Lifecycle, DuckDeath (duck-specific death visuals) and Gun
+    systemScheduler.run(jobSystem, deltaTime);
+    {
+        DUCK_PROFILE_SCOPE("DuckSpawnerManager::Update");
+        duckSpawnerManager->Update(deltaTime);
+    }
 
-    EntityManager.Update(deltaTime);
-    duckSpawnerManager->Update(deltaTime);
+    // Sync point: apply the creates/destroys recorded by the systems and the spawner, then drop dead entities.
+    {
+        DUCK_PROFILE_SCOPE("EntityManager::PlaybackCommands");
+        EntityManager.PlaybackCommands(*this);
+    }
+    {
+        DUCK_PROFILE_SCOPE("EntityManager::Update");
+        EntityManager.Update(deltaTime);
+    }
 }
 
 void World::beginPlay()
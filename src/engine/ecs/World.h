@@ -11,6 +11,8 @@
 #include "../ecs/system/LifecycleSystem.h"
 #include "../ecs/system/GunSystem.h"
 #include "../game/ecs/system/DuckDeathSystem.h"
+#include "../ecs/SystemScheduler.h"
+#include "../core/JobSystem.h"
 
 class DuckSpawnerManager;
 
@@ -19,7 +21,8 @@ class World
 public:
     Camera* camera;
     Shader* basicShader;
-    EntityManager EntityManager;
+    // Qualified: the member shares its type's name, which GCC rejects unless the type is spelled out.
+    ::EntityManager EntityManager;
     LightManager lightManager;
     CollisionSystem* collisionSystem = nullptr;
     DebugRenderSystem debugRenderSystem;
@@ -30,6 +33,14 @@ public:
     DuckDeathSystem duckDeathSystem;
     GunSystem gunSystem;
 
+    // How far rendering is between the previous and the latest fixed simulation step (0..1), set by the Engine.
+    // Entities moved by MovementSystem are drawn at mix(oldPosition, position, interpolationAlpha).
+    float interpolationAlpha = 1.0f;
+
+    // Runs the per-frame systems above as a job graph built from their declared component access.
+    JobSystem jobSystem;
+    SystemScheduler systemScheduler;
+
     World();
 
     void update(float deltaTime);
@@ -44,6 +55,8 @@ public:
     Entity* getGameStateEntity() const { return gameStateEntity; }
 
 private:
+    void registerSystems();
+
     Entity* gunEntity = nullptr;
     Entity* gameStateEntity = nullptr;
 
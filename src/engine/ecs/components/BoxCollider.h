@@ -6,4 +6,6 @@ struct BoxCollider {
     glm::vec3 center{0.0f};
     glm::vec3 size{1.0f};
     bool isTrigger = false;
+    // Static colliders go in a BVH that is never refit, so their Transform must not change after spawning.
+    bool isStatic = false;
 };
@@ -11,5 +11,6 @@ struct RaycastSource {
     bool lastHit = false;
     glm::vec3 lastHitPoint{};
 
+    // Generational handle, may outlive the entity. Resolve it with EntityManager::GetEntityByID.
     EntityID hitEntityID = INVALID_ENTITY_ID;
 };
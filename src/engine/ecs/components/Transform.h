@@ -7,5 +7,6 @@ struct Transform {
     glm::vec3 position{0.0f};
     glm::quat rotation{};
     glm::vec3 scale{1.0f};
+    // Position before the last fixed simulation step, kept by MovementSystem for render interpolation.
     glm::vec3 oldPosition{0.0f};
 };
@@ -10,15 +10,18 @@ void BoundsSystem::update(World& world, float deltaTime) {
     Entity* gameState = world.getGameStateEntity();
     if (!gameState) return;
 
-    for (auto& entity : world.EntityManager.GetEntities()) {
-        if (entity->hasComponent<Transform>() && entity->hasComponent<BoundsComponent>()) {
-            auto& transform = entity->getComponent<Transform>();
-            auto& bounds = entity->getComponent<BoundsComponent>();
+    // Destroys are deferred to the command buffer so the chunks stay untouched while other systems run.
+    EntityCommandBuffer& commands = world.EntityManager.GetCommandBuffer();
 
-            if (glm::distance(transform.position, bounds.spawnPosition) > bounds.escapeDistance) {
-                GameStateSystem::duckEscaped(*gameState);
-                entity->destroy();
+    world.EntityManager.ForEachChunk<Transform, BoundsComponent>(
+        [gameState, &commands](std::size_t count, Entity** entities, Transform* transforms, BoundsComponent* bounds) {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!entities[i]->getIsActive()) continue;
+
+                if (glm::distance(transforms[i].position, bounds[i].spawnPosition) > bounds[i].escapeDistance) {
+                    GameStateSystem::duckEscaped(*gameState);
+                    commands.destroyEntity(entities[i]->getID());
+                }
             }
-        }
-    }
+        });
 }
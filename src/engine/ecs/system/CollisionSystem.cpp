@@ -2,47 +2,210 @@
 #include "../src/engine/ecs/Component.h"
 #include "../src/engine/physics/RaycastUtils.h"
 #include "../system/EntityManager.h"
+#include "../src/engine/ecs/World.h"
+#include "../src/engine/core/JobSystem.h"
 
-CollisionSystem::RaycastResult CollisionSystem::Raycast(
-    EntityManager& entityManager,
-    const glm::vec3& origin,
-    const glm::vec3& direction,
-    float maxDistance)
-{
-    RaycastResult result;
-    float closestDistance = maxDistance;
+#include <algorithm>
+#include <cassert>
+
+namespace {
+    Physics::AABB getColliderBounds(const Transform& transform, const BoxCollider& collider) {
+        glm::vec3 scaledSize = collider.size * transform.scale;
+        glm::vec3 halfSize = scaledSize * 0.5f;
+        glm::vec3 worldCenter = transform.position + collider.center;
+        return Physics::AABB{worldCenter - halfSize, worldCenter + halfSize};
+    }
+
+    // Spreads the low 10 bits of v so there are two zero bits between each, for interleaving into a Morton code.
+    std::uint64_t spreadBits(std::uint32_t v) {
+        std::uint64_t x = v & 0x3ff;
+        x = (x | (x << 16)) & 0x30000ff;
+        x = (x | (x << 8)) & 0x300f00f;
+        x = (x | (x << 4)) & 0x30c30c3;
+        x = (x | (x << 2)) & 0x9249249;
+        return x;
+    }
 
-    auto entities = entityManager.GetEntitiesWith<Transform, BoxCollider>();
+    std::uint64_t mortonCode(const glm::vec3& normalized) {
+        glm::uvec3 q = glm::uvec3(glm::clamp(normalized, 0.0f, 1.0f) * 1023.0f);
+        return spreadBits(q.x) | (spreadBits(q.y) << 1) | (spreadBits(q.z) << 2);
+    }
+
+    // Sort key for ray coherence: direction octant first (rays in one octant traverse boxes in the same order),
+    // then the direction, then the origin within the batch bounds.
+    std::uint64_t rayCoherenceKey(const CollisionSystem::RayQuery& ray, const glm::vec3& originMin, const glm::vec3& originScale) {
+        std::uint64_t octant = (ray.direction.x < 0.0f ? 1u : 0u) |
+                               (ray.direction.y < 0.0f ? 2u : 0u) |
+                               (ray.direction.z < 0.0f ? 4u : 0u);
 
-    for (auto* entity : entities) {
-        if (!entity->getIsActive()) continue;
+        float length = glm::length(ray.direction);
+        glm::vec3 direction = length > 0.0f ? ray.direction / length * 0.5f + 0.5f : glm::vec3(0.5f);
+        // 7 bits per axis of direction and 10 per axis of origin leave room for the octant in 64 bits.
+        std::uint64_t directionCode = mortonCode(direction) >> 9;
+        std::uint64_t originCode = mortonCode((ray.origin - originMin) * originScale);
+
+        return (octant << 61) | (directionCode << 30) | originCode;
+    }
+
+    // Returns the entity behind a proxy if it can still be hit, i.e. it is active, still has a collider and
+    // is not dead (dead ducks shouldn't block raycasts).
+    Entity* getCollidableEntity(EntityManager& entityManager, EntityID id) {
+        Entity* entity = entityManager.GetEntityByID(id);
+        if (!entity || !entity->getIsActive()) return nullptr;
+        if (!entity->hasComponent<Transform>() || !entity->hasComponent<BoxCollider>()) return nullptr;
 
-        // Skip dead entities (they shouldn't block raycasts)
         if (entity->hasComponent<HealthComponent>()) {
             auto& health = entity->getComponent<HealthComponent>();
-            if (health.isDead) continue;
+            if (health.isDead) return nullptr;
         }
 
-        auto& transform = entity->getComponent<Transform>();
-        auto& collider = entity->getComponent<BoxCollider>();
+        return entity;
+    }
 
-        glm::vec3 scaledSize = collider.size * transform.scale;
-        glm::vec3 halfSize = scaledSize * 0.5f;
-        glm::vec3 worldCenter = transform.position + collider.center;
-        glm::vec3 aabbMin = worldCenter - halfSize;
-        glm::vec3 aabbMax = worldCenter + halfSize;
+    // Collider boxes of the leaves a ray reached, tested a group at a time with the batched kernel. A group is
+    // one AVX2 step; per thread so RaycastBatch's workers don't share it and its arrays are only allocated once.
+    struct LeafGroup {
+        static constexpr std::size_t CAPACITY = 8;
+        Physics::AABBBatch boxes;
+        EntityID ids[CAPACITY];
+    };
+    thread_local LeafGroup leafGroup;
+}
+
+void CollisionSystem::update(World& world, float /*deltaTime*/)
+{
+    ++frame;
+    frameColliders.clear();
 
-        Physics::RaycastHit hit = Physics::raycastAABB(
-            origin, direction, aabbMin, aabbMax
-        );
+    world.EntityManager.ForEachChunk<Transform, BoxCollider>(
+        [this](std::size_t count, Entity** entities, Transform* transforms, BoxCollider* colliders) {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!entities[i]->getIsActive()) continue;
 
-        if (hit.hit && hit.distance < closestDistance) {
-            result.hit = true;
-            result.hitEntityID = entity->getID();
-            result.hitInfo = hit;
-            closestDistance = hit.distance;
+                Physics::AABB bounds = getColliderBounds(transforms[i], colliders[i]);
+                EntityID id = entities[i]->getID();
+
+                auto [it, bInserted] = proxies.try_emplace(id);
+                ColliderProxy& proxy = it->second;
+                if (bInserted) {
+                    proxy.bStatic = colliders[i].isStatic;
+                    Physics::DynamicBVH& tree = proxy.bStatic ? staticTree : dynamicTree;
+                    proxy.proxyId = tree.createProxy(bounds, id);
+                } else if (!proxy.bStatic) {
+                    dynamicTree.moveProxy(proxy.proxyId, bounds);
+                }
+                proxy.lastSeenFrame = frame;
+
+                frameColliders.push_back({id, bounds, proxy.bStatic, colliders[i].isTrigger});
+            }
+        });
+
+    // Anything not visited this frame was deleted, deactivated or lost its collider.
+    std::erase_if(proxies, [this](const auto& entry) {
+        const ColliderProxy& proxy = entry.second;
+        if (proxy.lastSeenFrame == frame) return false;
+
+        (proxy.bStatic ? staticTree : dynamicTree).destroyProxy(proxy.proxyId);
+        return true;
+    });
+
+    detectOverlaps();
+}
+
+void CollisionSystem::detectOverlaps()
+{
+    // Cells twice the average size of a moving collider keep each one in a handful of cells. Props are large
+    // and never collide with each other, so they don't count towards the size.
+    float extentSum = 0.0f;
+    std::size_t dynamicCount = 0;
+    for (const FrameCollider& collider : frameColliders) {
+        if (collider.bStatic) continue;
+
+        glm::vec3 size = collider.bounds.max - collider.bounds.min;
+        extentSum += std::max(size.x, std::max(size.y, size.z));
+        ++dynamicCount;
+    }
+    if (dynamicCount == 0) return;
+
+    grid.clear(2.0f * extentSum / static_cast<float>(dynamicCount));
+    for (const FrameCollider& collider : frameColliders) {
+        grid.insert(collider.bounds, collider.bStatic);
+    }
+
+    overlappingPairs.clear();
+    grid.findOverlappingPairs(overlappingPairs);
+
+    for (const auto& [first, second] : overlappingPairs) {
+        const FrameCollider& a = frameColliders[first];
+        const FrameCollider& b = frameColliders[second];
+
+        if (a.bTrigger || b.bTrigger) {
+            if (a.bTrigger) eventQueue.emit(TriggerEvent{a.id, b.id});
+            if (b.bTrigger) eventQueue.emit(TriggerEvent{b.id, a.id});
+            continue;
         }
+
+        // Narrowphase: the pair already overlaps, so find the axis of least penetration for the contact normal.
+        glm::vec3 overlap = glm::min(a.bounds.max, b.bounds.max) - glm::max(a.bounds.min, b.bounds.min);
+        glm::vec3 centerDelta = (b.bounds.min + b.bounds.max) - (a.bounds.min + a.bounds.max);
+
+        int axis = 0;
+        if (overlap.y < overlap[axis]) axis = 1;
+        if (overlap.z < overlap[axis]) axis = 2;
+
+        glm::vec3 normal(0.0f);
+        normal[axis] = centerDelta[axis] < 0.0f ? -1.0f : 1.0f;
+
+        eventQueue.emit(ContactEvent{a.id, b.id, normal, overlap[axis]});
     }
+}
+
+CollisionSystem::RaycastResult CollisionSystem::Raycast(
+    EntityManager& entityManager,
+    const glm::vec3& origin,
+    const glm::vec3& direction,
+    float maxDistance)
+{
+    RaycastResult result;
+    LeafGroup& group = leafGroup;
+    group.boxes.clear();
+
+    // Tests the gathered leaves and keeps the closest hit; only the winning box gets raycastAABB for its point
+    // and normal.
+    auto flushGroup = [&](float closest) {
+        int index = Physics::raycastAABBBatch(origin, direction, group.boxes, closest);
+        if (index >= 0) {
+            glm::vec3 min(group.boxes.minX[index], group.boxes.minY[index], group.boxes.minZ[index]);
+            glm::vec3 max(group.boxes.maxX[index], group.boxes.maxY[index], group.boxes.maxZ[index]);
+            result.hit = true;
+            result.hitEntityID = group.ids[index];
+            result.hitInfo = Physics::raycastAABB(origin, direction, min, max);
+            closest = result.hitInfo.distance;
+        }
+        group.boxes.clear();
+        return closest;
+    };
+
+    // Leaves come nearest first, so a full group usually tightens the distance the rest of the tree is searched to.
+    auto testTree = [&](const Physics::DynamicBVH& tree, float closestDistance) {
+        tree.raycast(origin, direction, closestDistance, [&](int proxyId, float) {
+            Entity* entity = getCollidableEntity(entityManager, tree.getUserData(proxyId));
+            if (!entity) return closestDistance;
+
+            Physics::AABB bounds = getColliderBounds(entity->getComponent<Transform>(), entity->getComponent<BoxCollider>());
+            group.ids[group.boxes.size()] = entity->getID();
+            group.boxes.add(bounds.min, bounds.max);
+            if (group.boxes.size() == LeafGroup::CAPACITY) {
+                closestDistance = flushGroup(closestDistance);
+            }
+            return closestDistance;
+        });
+        flushGroup(closestDistance);
+    };
+
+    // Props first; a prop hit then bounds how deep the duck tree is searched.
+    testTree(staticTree, maxDistance);
+    testTree(dynamicTree, result.hit ? result.hitInfo.distance : maxDistance);
 
     return result;
 }
@@ -78,38 +241,64 @@ CollisionSystem::RaycastResult CollisionSystem::RaycastFromEntity(
     return result;
 }
 
-std::vector<Entity*> CollisionSystem::GetEntitiesInBox(
+void CollisionSystem::RaycastBatch(
     EntityManager& entityManager,
-    const glm::vec3& min,
-    const glm::vec3& max)
+    JobSystem& jobSystem,
+    std::span<const RayQuery> rays,
+    std::span<RaycastResult> results)
 {
-    std::vector<Entity*> results;
-    auto entities = entityManager.GetEntitiesWith<Transform, BoxCollider>();
-
-    for (auto* entity : entities) {
-        if (!entity->getIsActive()) continue;
+    assert(results.size() >= rays.size());
 
-        // Skip dead entities
-        if (entity->hasComponent<HealthComponent>()) {
-            auto& health = entity->getComponent<HealthComponent>();
-            if (health.isDead) continue;
+    if (rays.size() <= RAYS_PER_JOB) {
+        for (std::size_t i = 0; i < rays.size(); ++i) {
+            results[i] = Raycast(entityManager, rays[i].origin, rays[i].direction, rays[i].maxDistance);
         }
+        return;
+    }
 
-        auto& transform = entity->getComponent<Transform>();
-        auto& collider = entity->getComponent<BoxCollider>();
+    glm::vec3 originMin(FLT_MAX);
+    glm::vec3 originMax(-FLT_MAX);
+    for (const RayQuery& ray : rays) {
+        originMin = glm::min(originMin, ray.origin);
+        originMax = glm::max(originMax, ray.origin);
+    }
+    glm::vec3 originScale = 1.0f / glm::max(originMax - originMin, glm::vec3(1e-4f));
 
-        glm::vec3 scaledSize = collider.size * transform.scale;
-        glm::vec3 halfSize = scaledSize * 0.5f;
-        glm::vec3 worldCenter = transform.position + collider.center;
-        glm::vec3 aabbMin = worldCenter - halfSize;
-        glm::vec3 aabbMax = worldCenter + halfSize;
+    // (key, ray index) pairs; results still go to the ray's own slot.
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> order(rays.size());
+    for (std::size_t i = 0; i < rays.size(); ++i) {
+        order[i] = {rayCoherenceKey(rays[i], originMin, originScale), static_cast<std::uint32_t>(i)};
+    }
+    std::sort(order.begin(), order.end());
 
-        if (aabbMin.x <= max.x && aabbMax.x >= min.x &&
-            aabbMin.y <= max.y && aabbMax.y >= min.y &&
-            aabbMin.z <= max.z && aabbMax.z >= min.z) {
-            results.push_back(entity);
+    jobSystem.parallelFor(order.size(), RAYS_PER_JOB, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            const RayQuery& ray = rays[order[i].second];
+            results[order[i].second] = Raycast(entityManager, ray.origin, ray.direction, ray.maxDistance);
         }
+    });
+}
+
+std::vector<Entity*> CollisionSystem::GetEntitiesInBox(
+    EntityManager& entityManager,
+    const glm::vec3& min,
+    const glm::vec3& max)
+{
+    std::vector<Entity*> results;
+    Physics::AABB box{min, max};
+
+    for (const Physics::DynamicBVH* tree : {&staticTree, &dynamicTree}) {
+        tree->queryAABB(box, [&](int proxyId) {
+            Entity* entity = getCollidableEntity(entityManager, tree->getUserData(proxyId));
+            if (!entity) return;
+
+            // The tree only tested the fat box.
+            Physics::AABB bounds = getColliderBounds(entity->getComponent<Transform>(), entity->getComponent<BoxCollider>());
+            if (bounds.overlaps(box)) {
+                results.push_back(entity);
+            }
+        });
     }
 
     return results;
-}
\ No newline at end of file
+}
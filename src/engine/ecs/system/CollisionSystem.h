@@ -1,11 +1,19 @@
 #pragma once
 #include "../src/engine/physics/RaycastUtils.h"
+#include "../src/engine/physics/DynamicBVH.h"
+#include "../src/engine/physics/SpatialHashGrid.h"
+#include "../src/engine/game/EventQueue.h"
 #include "../Entity.h"
 #include <vector>
 #include <cfloat>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
 
 class EntityManager;
 class Entity;
+class World;
+class JobSystem;
 
 class CollisionSystem {
 public:
@@ -15,6 +23,22 @@ public:
         Physics::RaycastHit hitInfo;
     };
 
+    struct RayQuery {
+        glm::vec3 origin{0.0f};
+        glm::vec3 direction{0.0f, 0.0f, -1.0f};
+        float maxDistance = FLT_MAX;
+    };
+
+    // Syncs the BVHs with the Transform+BoxCollider entities: new colliders get a proxy, moving ones are
+    // refit and proxies of deleted entities are dropped. Runs once per frame, before anything raycasts.
+    // Then finds every overlapping collider pair and emits a ContactEvent or TriggerEvent for it.
+    void update(World& world, float deltaTime);
+
+    // ContactEvent/TriggerEvent queues, filled by every update() since the last clearEvents(). The engines clear
+    // them once per frame before stepping, so they hold the overlaps of all of that frame's fixed steps.
+    const EventQueue& getEvents() const { return eventQueue; }
+    void clearEvents() { eventQueue.clear(); }
+
     RaycastResult Raycast(EntityManager& entityManager,
                          const glm::vec3& origin,
                          const glm::vec3& direction,
@@ -22,7 +46,51 @@ public:
 
     RaycastResult RaycastFromEntity(EntityManager& entityManager, Entity& entity);
 
+    // Casts every ray and writes the result of rays[i] to results[i]; results must be at least as long as rays.
+    // Rays are sorted so that neighbouring rays (same direction octant, similar direction and origin) walk the
+    // same BVH nodes, then split across the job system's workers. Only reads the BVHs and components, so it
+    // must not overlap update() or anything writing Transform/BoxCollider/HealthComponent.
+    void RaycastBatch(EntityManager& entityManager,
+                      JobSystem& jobSystem,
+                      std::span<const RayQuery> rays,
+                      std::span<RaycastResult> results);
+
     std::vector<Entity*> GetEntitiesInBox(EntityManager& entityManager,
                                           const glm::vec3& min,
                                           const glm::vec3& max);
+
+private:
+    // How far a dynamic collider's fat box extends past its real box, in world units.
+    static constexpr float DYNAMIC_MARGIN = 0.5f;
+
+    // Rays per job in RaycastBatch; smaller batches are cast on the calling thread without sorting.
+    static constexpr std::size_t RAYS_PER_JOB = 64;
+
+    struct FrameCollider {
+        EntityID id;
+        Physics::AABB bounds;
+        bool bStatic;
+        bool bTrigger;
+    };
+
+    void detectOverlaps();
+
+    struct ColliderProxy {
+        int proxyId = Physics::DynamicBVH::NULL_NODE;
+        bool bStatic = false;
+        std::uint32_t lastSeenFrame = 0;
+    };
+
+    // Colliders flagged isStatic (environment props) are inserted once and never refit.
+    Physics::DynamicBVH staticTree{0.0f};
+    Physics::DynamicBVH dynamicTree{DYNAMIC_MARGIN};
+
+    std::unordered_map<EntityID, ColliderProxy> proxies;
+    std::uint32_t frame = 0;
+
+    // Broadphase state, rebuilt every frame from the colliders gathered while syncing the BVHs.
+    std::vector<FrameCollider> frameColliders;
+    Physics::SpatialHashGrid grid;
+    std::vector<Physics::SpatialHashGrid::Pair> overlappingPairs;
+    EventQueue eventQueue;
 };
@@ -3,14 +3,16 @@
 #include "EntityManager.h"
 #include "../src/engine/ecs/Component.h"
 #include "../src/engine/debug/DebugRenderer.h"
+#include "../src/engine/game/EventQueue.h"
 
 void DebugRenderSystem::init() {
     DebugRenderer::getInstance().init();
 }
 
-void DebugRenderSystem::render(EntityManager& entityManager, Shader& debugShader) {
+void DebugRenderSystem::render(EntityManager& entityManager, const EventQueue& collisionEvents, Shader& debugShader) {
     drawColliders(entityManager, debugShader);
     drawRaycasts(entityManager, debugShader);
+    drawContacts(entityManager, collisionEvents, debugShader);
 }
 
 void DebugRenderSystem::drawColliders(EntityManager& entityManager, Shader& debugShader) {
@@ -56,6 +58,24 @@ void DebugRenderSystem::drawRaycasts(EntityManager& entityManager, Shader& debug
     }
 }
 
+void DebugRenderSystem::drawContacts(EntityManager& entityManager, const EventQueue& collisionEvents, Shader& debugShader) {
+    auto drawPair = [&](EntityID a, EntityID b, bool bTrigger) {
+        Entity* first = entityManager.GetEntityByID(a);
+        Entity* second = entityManager.GetEntityByID(b);
+        if (!first || !second || !first->hasComponent<Transform>() || !second->hasComponent<Transform>()) return;
+
+        DebugRenderer::getInstance().drawLine(debugShader, first->getComponent<Transform>().position,
+                                              second->getComponent<Transform>().position, bTrigger);
+    };
+
+    for (const ContactEvent& contact : collisionEvents.get<ContactEvent>()) {
+        drawPair(contact.entityA, contact.entityB, false);
+    }
+    for (const TriggerEvent& trigger : collisionEvents.get<TriggerEvent>()) {
+        drawPair(trigger.triggerEntity, trigger.otherEntity, true);
+    }
+}
+
 void DebugRenderSystem::cleanup() {
     DebugRenderer::getInstance().cleanup();
 }
\ No newline at end of file
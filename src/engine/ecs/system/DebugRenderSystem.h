@@ -3,14 +3,18 @@
 #include "../src/engine/renderer/Shader.h"
 
 class EntityManager;
+class EventQueue;
 class Shader;
 
 class DebugRenderSystem {
 
 public:
     static void init();
-    void render(EntityManager& entityManager, Shader& debugShader);
+    void render(EntityManager& entityManager, const EventQueue& collisionEvents, Shader& debugShader);
     static void drawColliders(EntityManager& entityManager, Shader& debugShader);
     static void drawRaycasts(EntityManager& entityManager, Shader& debugShader);
+    // A line between the centers of every pair CollisionSystem reported this frame: red for contacts, green for
+    // triggers.
+    static void drawContacts(EntityManager& entityManager, const EventQueue& collisionEvents, Shader& debugShader);
     static void cleanup();
 };
\ No newline at end of file
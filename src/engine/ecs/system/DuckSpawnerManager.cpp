@@ -48,7 +48,13 @@ void DuckSpawnerManager::SpawnDuck()
 
     // TODO: Half-ring Solution
     int randomIndex = rand() % spawnPositions.size();
-    DuckFactory::createDuck(*world, spawnPositions[randomIndex], GameStateSystem::getDuckSpeed(*gameState));
+    glm::vec3 position = spawnPositions[randomIndex];
+    float speed = GameStateSystem::getDuckSpeed(*gameState);
+
+    // Created at the next command playback rather than while the entity list may be iterated.
+    world->EntityManager.GetCommandBuffer().createEntity([this, position, speed](Entity& duck) {
+        DuckFactory::setupDuck(*world, duck, position, speed);
+    });
 
     GameStateSystem::spawnDuck(*gameState);  // Just marks UI slot as spawned
     AudioManager::Get().PlaySound("quack", 1.0f);
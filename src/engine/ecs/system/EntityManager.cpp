@@ -25,21 +25,77 @@ Entity* EntityManager::GetEntityByID(EntityID id)
         return nullptr;
     }
 
-    for (auto& entity : Entities) {
-        if (entity && entity->getID() == id) {
-            return entity.get();
-        }
+    std::uint32_t index = getEntityIndex(id);
+    if (index >= EntitySlots.size()) {
+        return nullptr;
+    }
+
+    const EntitySlot& slot = EntitySlots[index];
+    if (slot.generation != getEntityGeneration(id)) {
+        return nullptr;
+    }
+
+    return slot.entity;
+}
+
+EntityID EntityManager::AllocateEntityID(Entity& entity)
+{
+    std::uint32_t index;
+    if (!FreeEntitySlots.empty()) {
+        index = FreeEntitySlots.back();
+        FreeEntitySlots.pop_back();
+    } else {
+        index = static_cast<std::uint32_t>(EntitySlots.size());
+        EntitySlots.emplace_back();
+    }
+
+    EntitySlot& slot = EntitySlots[index];
+    slot.entity = &entity;
+    return makeEntityID(index, slot.generation);
+}
+
+void EntityManager::ReleaseEntityID(EntityID id)
+{
+    std::uint32_t index = getEntityIndex(id);
+    if (index >= EntitySlots.size()) return;
+
+    EntitySlot& slot = EntitySlots[index];
+    if (slot.generation != getEntityGeneration(id)) return;
+
+    slot.entity = nullptr;
+    slot.listIndex = NOT_LISTED;
+    // Generation 0 is skipped on wrap-around so a recycled slot can never produce INVALID_ENTITY_ID.
+    if (++slot.generation == 0) {
+        slot.generation = 1;
     }
+    FreeEntitySlots.push_back(index);
+}
+
+EntityQuery& EntityManager::GetQuery(const ComponentBitSet& signature)
+{
+    std::lock_guard<std::mutex> lock(QueriesMutex);
 
-    return nullptr;
+    auto& query = Queries[signature];
+    if (!query) {
+        query = std::make_unique<EntityQuery>(signature);
+    }
+
+    query->updateArchetypes(Storage);
+    return *query;
 }
 
 Entity& EntityManager::CreateEntity(World& InWorld)
 {
-    Entities.emplace_back(std::make_unique<Entity>(InWorld));
+    AddToEntities(std::make_unique<Entity>(InWorld));
     return *Entities.back();
 }
 
+void EntityManager::AddToEntities(std::unique_ptr<Entity> entity)
+{
+    EntitySlots[getEntityIndex(entity->getID())].listIndex = static_cast<std::uint32_t>(Entities.size());
+    Entities.emplace_back(std::move(entity));
+}
+
 Entity& EntityManager::CreateDeferredEntity(World& InWorld)
 {
     DeferredEntities.emplace_back(std::make_unique<Entity>(InWorld));
@@ -50,22 +106,82 @@ Entity& EntityManager::CreateDeferredEntity(World& InWorld)
 void EntityManager::SynchronizeEntities()
 {
     if (!DeferredEntities.empty()) {
-        std::move(DeferredEntities.begin(), DeferredEntities.end(), std::back_inserter(Entities));
+        for (auto& entity : DeferredEntities) {
+            AddToEntities(std::move(entity));
+        }
         DeferredEntities.clear();
     }
 }
 
+EntityCommandBuffer& EntityManager::GetCommandBuffer()
+{
+    std::lock_guard<std::mutex> lock(CommandBuffersMutex);
+
+    auto& buffer = ThreadCommandBuffers[std::this_thread::get_id()];
+    if (!buffer) {
+        CommandBuffers.emplace_back(std::make_unique<EntityCommandBuffer>());
+        buffer = CommandBuffers.back().get();
+    }
+    return *buffer;
+}
+
+void EntityManager::PlaybackCommands(World& InWorld)
+{
+    // Playing back a buffer can record new commands (from create callbacks), so repeat until all are drained.
+    bool bPlayedBack = true;
+    while (bPlayedBack) {
+        bPlayedBack = false;
+        for (std::size_t i = 0; i < CommandBuffers.size(); ++i) {
+            if (CommandBuffers[i]->isEmpty()) continue;
+
+            CommandBuffers[i]->playback(InWorld);
+            bPlayedBack = true;
+        }
+    }
+
+    SynchronizeEntities();
+}
+
 void EntityManager::Update(float deltaTime)
 {
-    // TODO: Cleanup at the end.
+    if (DeadEntities.empty()) return;
+
+    if (CleanupThreshold > 0.0f &&
+        static_cast<float>(DeadEntities.size()) < CleanupThreshold * static_cast<float>(Entities.size())) {
+        return;
+    }
+
     CleanupInactiveEntities();
 }
 
+void EntityManager::QueueForCleanup(EntityID id)
+{
+    DeadEntities.push_back(id);
+}
+
 void EntityManager::CleanupInactiveEntities()
 {
-    std::erase_if(
-        Entities,
-        [](std::unique_ptr<Entity>& e) {
-            return !e->bIsActive;
-        });
+    std::size_t keptCount = 0;
+
+    for (EntityID id : DeadEntities) {
+        Entity* entity = GetEntityByID(id);
+        if (!entity) continue;
+
+        std::uint32_t index = EntitySlots[getEntityIndex(id)].listIndex;
+        if (index == NOT_LISTED) {
+            // Destroyed while still deferred; it is removed after SynchronizeEntities lists it.
+            DeadEntities[keptCount++] = id;
+            continue;
+        }
+
+        if (index != Entities.size() - 1) {
+            std::swap(Entities[index], Entities.back());
+            EntitySlots[getEntityIndex(Entities[index]->getID())].listIndex = index;
+        }
+
+        // Releases the entity's slot and archetype row; its memory goes back to the entity pool.
+        Entities.pop_back();
+    }
+
+    DeadEntities.resize(keptCount);
 }
\ No newline at end of file
@@ -1,8 +1,16 @@
 #pragma once
 #include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "../src/engine/ecs/Entity.h"
+#include "../src/engine/ecs/ArchetypeStorage.h"
+#include "../src/engine/ecs/EntityQuery.h"
+#include "../src/engine/ecs/EntityCommandBuffer.h"
+#include "../src/engine/core/JobSystem.h"
 
 class EntityManager {
 
@@ -13,44 +21,138 @@ public:
 
     std::vector<std::unique_ptr<Entity>>& GetEntities();
 
+    // O(1) lookup; returns nullptr if the entity has been deleted, even if its slot was reused since.
     Entity* GetEntityByID(EntityID id);
 
+    // Called by Entity on construction/destruction to claim and release a handle slot.
+    EntityID AllocateEntityID(Entity& entity);
+
+    void ReleaseEntityID(EntityID id);
+
     Entity& CreateEntity(World& InWorld);
 
     Entity& CreateDeferredEntity(World& InWorld);
 
     void SynchronizeEntities();
 
+    // Command buffer of the calling thread. Systems record structural changes here instead of applying them
+    // mid-iteration; safe to call from jobs running on worker threads.
+    EntityCommandBuffer& GetCommandBuffer();
+
+    // Sync point: applies every thread's recorded commands and then synchronizes deferred entities.
+    // Must not be called while systems are running.
+    void PlaybackCommands(World& InWorld);
+
     void Update(float deltaTime);
 
+    // Deletes every destroyed entity. Each one is swapped with the last entity and popped, so the cost
+    // depends on the number of dead entities rather than on the size of the list.
     void CleanupInactiveEntities();
 
+    // Called by Entity::destroy. Not thread-safe; systems destroy through the command buffer instead.
+    void QueueForCleanup(EntityID id);
+
+    // With a ratio above 0, Update only cleans up once that fraction of the entity list is dead, batching the
+    // deletes of many frames into one. Destroyed entities stay in GetEntities() until then, flagged inactive.
+    void SetCleanupThreshold(float deadRatio) { CleanupThreshold = deadRatio; }
+
+    // Returns the active entities that have all Components from a cached query; no scan or allocation happens
+    // unless an archetype the query matches changed. The span is invalidated by the next call with the same
+    // component set, so copy it if you need to hold on to it.
     template<typename... Components>
-    std::vector<Entity*> GetEntitiesWith();
+    std::span<Entity* const> GetEntitiesWith();
+
+    // Persistent query for a component signature, created on first use.
+    EntityQuery& GetQuery(const ComponentBitSet& signature);
+
+    // Calls func(count, entities, columns...) once per non-empty chunk whose archetype has all Components,
+    // where each column is a contiguous array of `count` components. Preferred over GetEntities() for hot loops.
+    template<typename... Components, typename Func>
+    void ForEachChunk(Func&& func);
+
+    // Same as ForEachChunk, but the chunks are split across the job system's workers. func runs concurrently
+    // and must only touch the columns it is handed.
+    template<typename... Components, typename Func>
+    void ForEachChunkParallel(JobSystem& jobSystem, Func&& func);
+
+    ArchetypeStorage& GetArchetypeStorage() { return Storage; }
 
     template <typename T, typename... Args>
     T& CreateEntityOfType(World& InWorld, Args&&... ConstructorArgs);
 
 private:
+    static constexpr std::uint32_t NOT_LISTED = UINT32_MAX;
+
+    struct EntitySlot {
+        Entity* entity = nullptr;
+        std::uint32_t generation = 1;
+        // Position of the entity in Entities, or NOT_LISTED while it is still deferred.
+        std::uint32_t listIndex = NOT_LISTED;
+    };
+
+    void AddToEntities(std::unique_ptr<Entity> entity);
+
+    // Declared before the entity lists so they outlive them; entities release their rows and slots on destruction.
+    ArchetypeStorage Storage;
+
+    std::vector<EntitySlot> EntitySlots;
+    std::vector<std::uint32_t> FreeEntitySlots;
+
     std::vector<std::unique_ptr<Entity>> Entities;
 
     std::vector<std::unique_ptr<Entity>> DeferredEntities;
+
+    std::vector<EntityID> DeadEntities;
+    float CleanupThreshold = 0.0f;
+
+    std::unordered_map<ComponentBitSet, std::unique_ptr<EntityQuery>> Queries;
+    std::mutex QueriesMutex;
+
+    // One buffer per thread that ever recorded commands, played back in the order the threads first recorded.
+    std::vector<std::unique_ptr<EntityCommandBuffer>> CommandBuffers;
+    std::unordered_map<std::thread::id, EntityCommandBuffer*> ThreadCommandBuffers;
+    std::mutex CommandBuffersMutex;
 };
 
 template<typename... Components>
-std::vector<Entity*> EntityManager::GetEntitiesWith() {
-    std::vector<Entity*> result;
+std::span<Entity* const> EntityManager::GetEntitiesWith() {
+    return GetQuery(getComponentSignature<Components...>()).getEntities();
+}
 
-    for (auto& entity : Entities) {
-        if (!entity) continue;
-        if (!entity->getIsActive()) continue;
+template<typename... Components, typename Func>
+void EntityManager::ForEachChunk(Func&& func) {
+    EntityQuery& query = GetQuery(getComponentSignature<Components...>());
 
-        if ((entity->template hasComponent<Components>() && ...)) {
-            result.push_back(entity.get());
+    for (Archetype* archetype : query.getArchetypes()) {
+        for (std::size_t i = 0; i < archetype->getChunkCount(); ++i) {
+            ArchetypeChunk& chunk = archetype->getChunk(i);
+            func(static_cast<std::size_t>(chunk.count), archetype->getEntities(chunk),
+                 archetype->template getColumn<Components>(chunk)...);
         }
     }
+}
 
-    return result;
+template<typename... Components, typename Func>
+void EntityManager::ForEachChunkParallel(JobSystem& jobSystem, Func&& func) {
+    EntityQuery& query = GetQuery(getComponentSignature<Components...>());
+
+    // Local rather than cached: a thread waiting in parallelFor may pick up another system's job that
+    // calls back into here.
+    std::vector<std::pair<Archetype*, ArchetypeChunk*>> chunks;
+
+    for (Archetype* archetype : query.getArchetypes()) {
+        for (std::size_t i = 0; i < archetype->getChunkCount(); ++i) {
+            chunks.emplace_back(archetype, &archetype->getChunk(i));
+        }
+    }
+
+    jobSystem.parallelFor(chunks.size(), 1, [&chunks, &func](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            auto [archetype, chunk] = chunks[i];
+            func(static_cast<std::size_t>(chunk->count), archetype->getEntities(*chunk),
+                 archetype->template getColumn<Components>(*chunk)...);
+        }
+    });
 }
 
 template <typename T, typename... Args>
@@ -59,6 +161,6 @@ T& EntityManager::CreateEntityOfType(World& InWorld, Args&&... ConstructorArgs)
     static_assert(std::is_base_of<Entity, T>::value, "T must derive from Entity class");
     std::unique_ptr<T> NewEntity = std::make_unique<T>(InWorld, std::forward<Args>(ConstructorArgs)...);
     T* EntityPtr = NewEntity.get(); // must cache this before calling std::move() if we want to return it
-    Entities.emplace_back(std::move(NewEntity)); // unique_ptr<T> automatically converts to unique_ptr<Entity>
+    AddToEntities(std::move(NewEntity)); // unique_ptr<T> automatically converts to unique_ptr<Entity>
     return *EntityPtr;
 }
\ No newline at end of file
@@ -18,9 +18,12 @@ void GunSystem::update(World& world, Camera& camera, float deltaTime) {
     // Get all entities with Gun and Transform components
     auto gunEntities = world.EntityManager.GetEntitiesWith<GunComponent, Transform>();
 
+    // The gun's Transform is set at the sync point, so this system only writes GunComponent and can run
+    // alongside everything that reads Transform.
+    EntityCommandBuffer& commands = world.EntityManager.GetCommandBuffer();
+
     for (auto* entity : gunEntities) {
         auto& gun = entity->getComponent<GunComponent>();
-        auto& transform = entity->getComponent<Transform>();
 
         // Lerp recoil values back to 0 over time
         gun.recoilOffset = glm::mix(gun.recoilOffset, 0.0f, deltaTime * gun.recoilRecoverySpeed);
@@ -32,7 +35,7 @@ void GunSystem::update(World& world, Camera& camera, float deltaTime) {
                          + (camera.up * gun.cameraOffset.y)
                          + (camera.front * gun.cameraOffset.z);
 
-        transform.position = camera.position + offset + kickback;
+        glm::vec3 position = camera.position + offset + kickback;
 
         // Lock to camera orientation + recoil pitch
         glm::mat3 camRotation(camera.right, camera.up, -camera.front);
@@ -45,7 +48,10 @@ void GunSystem::update(World& world, Camera& camera, float deltaTime) {
         // Apply base yaw offset
         orientation = orientation * glm::angleAxis(glm::radians(gun.baseYawOffset), glm::vec3(0, 1, 0));
 
-        transform.rotation = orientation;
+        commands.editComponent<Transform>(entity->getID(), [position, orientation](Transform& transform) {
+            transform.position = position;
+            transform.rotation = orientation;
+        });
     }
 }
 
@@ -6,34 +6,37 @@
 #include "../src/engine/ecs/components/HealthComponent.h"
 
 void LifecycleSystem::update(World& world, float deltaTime) {
-    for (auto& entity : world.EntityManager.GetEntities()) {
-        if (entity->hasComponent<HealthComponent>() && entity->hasComponent<Transform>()) {
-            auto& health = entity->getComponent<HealthComponent>();
-            auto& transform = entity->getComponent<Transform>();
+    EntityCommandBuffer& commands = world.EntityManager.GetCommandBuffer();
 
-            if (health.isDead) {
-                health.timeSinceDeath += deltaTime;
+    world.EntityManager.ForEachChunk<HealthComponent, Transform>(
+        [deltaTime, &commands](std::size_t count, Entity** entities, HealthComponent* healths, Transform* transforms) {
+            for (std::size_t i = 0; i < count; ++i) {
+                auto& health = healths[i];
+                Entity* entity = entities[i];
 
-                // Wait for the "pause" to finish, then start falling
-                if (health.timeSinceDeath > health.pauseAfterKillDuration && !health.isFalling) {
-                    health.isFalling = true;
+                if (health.isDead) {
+                    health.timeSinceDeath += deltaTime;
 
-                    if(entity->hasComponent<Velocity>()) {
-                        auto& velocity = entity->getComponent<Velocity>();
+                    // Wait for the "pause" to finish, then start falling
+                    if (health.timeSinceDeath > health.pauseAfterKillDuration && !health.isFalling) {
+                        health.isFalling = true;
 
-                        // Since MovementSystem is now World Space, we just set direction to World Down.
-                        velocity.Direction = glm::vec3(0.0f, -1.0f, 0.0f);
-                        velocity.Speed = 50.0f; // Set a fast fall speed
+                        if(entity->hasComponent<Velocity>()) {
+                            auto& velocity = entity->getComponent<Velocity>();
+
+                            // Since MovementSystem is now World Space, we just set direction to World Down.
+                            velocity.Direction = glm::vec3(0.0f, -1.0f, 0.0f);
+                            velocity.Speed = 50.0f; // Set a fast fall speed
+                        }
                     }
                 }
-            }
 
-            // Destroy if below the death plane
-            if (transform.position.y < health.DeathPlaneYBound) {
-                entity->destroy();
+                // Destroy if below the death plane
+                if (transforms[i].position.y < health.DeathPlaneYBound) {
+                    commands.destroyEntity(entity->getID());
+                }
             }
-        }
-    }
+        });
 }
 
 void LifecycleSystem::killEntity(Entity& entity) {
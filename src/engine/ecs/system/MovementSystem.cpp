@@ -5,16 +5,19 @@
 #include "../src/engine/ecs/components/Velocity.h"
 
 void MovementSystem::update(World& world, float deltaTime) {
-    for (auto& entity : world.EntityManager.GetEntities()) {
-        if (entity->hasComponent<Transform>() && entity->hasComponent<Velocity>()) {
-            auto& transform = entity->getComponent<Transform>();
-            auto& velocity = entity->getComponent<Velocity>();
+    // Each entity only touches its own Transform, so chunks are integrated in parallel.
+    world.EntityManager.ForEachChunkParallel<Transform, Velocity>(world.jobSystem,
+        [deltaTime](std::size_t count, Entity**, Transform* transforms, Velocity* velocities) {
+            for (std::size_t i = 0; i < count; ++i) {
+                auto& transform = transforms[i];
+                const auto& velocity = velocities[i];
 
-            transform.position += velocity.Direction * velocity.Speed * deltaTime;
+                transform.oldPosition = transform.position;
+                transform.position += velocity.Direction * velocity.Speed * deltaTime;
 
-            if (glm::length(velocity.Direction) > 0.01f) {
-                transform.rotation = glm::quatLookAt(glm::normalize(-velocity.Direction), glm::vec3(0, 1, 0));
+                if (glm::length(velocity.Direction) > 0.01f) {
+                    transform.rotation = glm::quatLookAt(glm::normalize(-velocity.Direction), glm::vec3(0, 1, 0));
+                }
             }
-        }
-    }
+        });
 }
\ No newline at end of file
@@ -3,50 +3,110 @@
 #include "../src/engine/ecs/Entity.h"
 #include "../src/engine/ecs/components/Transform.h"
 #include "../src/engine/ecs/components/StaticMeshComponent.h"
+#include "../src/engine/ecs/components/Velocity.h"
 #include "../src/engine/renderer/Shader.h"
 #include "../src/engine/renderer/Camera.h"
 #include "../src/engine/renderer/Material.h"
 #include "../src/engine/core/model/StaticMesh.h"
 #include "TransformSystem.h"
+#include "../../debug/Profiler.h"
+#include "../../renderer/Frustum.h"
 
-#include <unordered_map>
-#include <vector>
 
 void RenderingSystem::renderEntities(World& world, Shader& shader, Camera& camera, Material& defaultMaterial) {
+    DUCK_PROFILE_SCOPE("RenderingSystem::renderEntities");
     shader.use();
 
     glm::mat4 view = camera.getViewMatrix();
     glm::mat4 projection = camera.getProjectionMatrix();
 
-    shader.setMat4("view", view);
-    shader.setMat4("projection", projection);
+    // view and projection come from the FrameData uniform block; they are only needed here for culling
 
-    std::unordered_map<Material*, std::vector<Entity*>> materialBatches;
+    candidates.clear();
+    candidateBounds.clear();
+    world.EntityManager.ForEachChunk<Transform, StaticMeshComponent>(
+        [&](std::size_t count, Entity** entities, Transform* transforms, StaticMeshComponent* meshComponents) {
+            // Only MovementSystem keeps oldPosition up to date, so only moving entities are interpolated.
+            // A chunk holds a single archetype, so its first entity answers for all of them.
+            bool bInterpolate = entities[0]->hasComponent<Velocity>();
 
-    for (auto& entity : world.EntityManager.GetEntities()) {
-        if (entity == nullptr) continue;
-        if (entity->hasComponent<StaticMeshComponent>() && entity->hasComponent<Transform>()) {
-            auto& staticMeshComponent = entity->getComponent<StaticMeshComponent>();
-            if (!staticMeshComponent.bIsVisible) continue;
+            for (std::size_t i = 0; i < count; ++i) {
+                if (!entities[i]->getIsActive()) continue;
+                const StaticMeshComponent& staticMeshComponent = meshComponents[i];
+                if (!staticMeshComponent.bIsVisible || !staticMeshComponent.Mesh) continue;
 
-            Material* mat = staticMeshComponent.material ? staticMeshComponent.material.get() : &defaultMaterial;
-            materialBatches[mat].push_back(entity.get());
+                glm::mat4 model = bInterpolate
+                    ? TransformSystem::getInterpolatedTransformMatrix(transforms[i], world.interpolationAlpha)
+                    : TransformSystem::getTransformMatrix(transforms[i]);
+
+                StaticMesh* mesh = staticMeshComponent.Mesh.get();
+                glm::vec3 worldMin, worldMax;
+                transformAABB(model, mesh->getMinBounds(), mesh->getMaxBounds(), worldMin, worldMax);
+                candidateBounds.add(worldMin, worldMax);
+
+                Material* mat = staticMeshComponent.material ? staticMeshComponent.material.get() : &defaultMaterial;
+                candidates.push_back({mat, mesh, model});
+            }
+        });
+
+    candidateVisible.resize(candidates.size());
+    cullAABBBatch(Frustum::fromViewProjection(projection * view), candidateBounds, candidateVisible.data());
+
+    renderQueue.clear();
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+        if (!candidateVisible[i]) continue;
+        const MeshCandidate& candidate = candidates[i];
+        float viewDepth = glm::dot(glm::vec3(candidate.model[3]) - camera.position, camera.front) / camera.farPlane;
+        renderQueue.submit(RenderPass::GEOMETRY, &shader, candidate.material, candidate.mesh, candidate.model, viewDepth);
+    }
+    if (renderQueue.empty()) return;
+    renderQueue.sort();
+
+    // Equal state is contiguous after sorting, so every run becomes one batch with its instances back to back
+    batches.clear();
+    instanceMatrices.clear();
+    for (std::size_t i = 0; i < renderQueue.size(); ++i) {
+        const RenderItem& item = renderQueue.getItem(i);
+        if (batches.empty() || !RenderQueue::sameState(*batches.back().item, item)) {
+            batches.push_back({&item, static_cast<std::uint32_t>(instanceMatrices.size()), 0});
         }
+        ++batches.back().instanceCount;
+        instanceMatrices.push_back(item.model);
     }
 
-    for (auto& [material, entities] : materialBatches) {
-        material->bind(shader);
+    if (instanceVBO == 0) {
+        glGenBuffers(1, &instanceVBO);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    // Respecifying the whole buffer lets the driver hand out fresh storage instead of waiting on last frame's draws
+    glBufferData(GL_ARRAY_BUFFER, instanceMatrices.size() * sizeof(glm::mat4), instanceMatrices.data(), GL_STREAM_DRAW);
 
-        for (auto* entity : entities) {
-            auto& transform = entity->getComponent<Transform>();
-            glm::mat4 model = TransformSystem::getTransformMatrix(transform);
-            shader.setMat4("model", model);
+    shader.setBool("instanced", true);
 
-            auto& staticMeshComponent = entity->getComponent<StaticMeshComponent>();
-            staticMeshComponent.Mesh->bind();
-            staticMeshComponent.Mesh->draw();
+    // Only touch GL state that differs from the previous batch
+    Shader* boundShader = &shader;
+    Material* boundMaterial = nullptr;
+    for (const DrawBatch& batch : batches) {
+        const RenderItem& item = *batch.item;
+        if (item.shader != boundShader) {
+            item.shader->use();
+            boundShader = item.shader;
+        }
+        if (item.material != boundMaterial) {
+            item.material->bind(*item.shader);
+            boundMaterial = item.material;
         }
+
+        item.mesh->bind();
+        item.mesh->bindInstanceData(instanceVBO, batch.firstInstance * sizeof(glm::mat4));
+        item.mesh->drawInstanced(static_cast<GLsizei>(batch.instanceCount));
     }
 
     glBindVertexArray(0);
+    shader.setBool("instanced", false);
+}
+
+void RenderingSystem::cleanup() {
+    if (instanceVBO) glDeleteBuffers(1, &instanceVBO);
+    instanceVBO = 0;
 }
@@ -1,11 +1,45 @@
 #pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "../../renderer/RenderQueue.h"
+#include "../../physics/RaycastUtils.h"
 
 class World;
 class Shader;
 class Camera;
 class Material;
+class StaticMesh;
 
 class RenderingSystem {
 public:
+    // Draws every visible StaticMeshComponent inside the camera frustum, with one instanced draw call per run of
+    // equal state in the render queue
     void renderEntities(World& world, Shader& shader, Camera& camera, Material& defaultMaterial);
+    void cleanup();
+
+private:
+    // Consecutive queue items drawn with one instanced call
+    struct DrawBatch {
+        const RenderItem* item;
+        std::uint32_t firstInstance;
+        std::uint32_t instanceCount;
+    };
+
+    // Meshes gathered for culling; bounds[i] is the world-space box of candidates[i]
+    struct MeshCandidate {
+        Material* material;
+        StaticMesh* mesh;
+        glm::mat4 model;
+    };
+
+    // All persistent so that submitting a frame does not allocate once the buffers have grown to fit the scene
+    std::vector<MeshCandidate> candidates;
+    Physics::AABBBatch candidateBounds;
+    std::vector<std::uint8_t> candidateVisible;
+    RenderQueue renderQueue;
+    std::vector<DrawBatch> batches;
+    // Model matrices of the whole frame in queue order, streamed into instanceVBO once per frame
+    std::vector<glm::mat4> instanceMatrices;
+    GLuint instanceVBO = 0;
 };
@@ -33,6 +33,14 @@ void TransformSystem::WorldRotate(Transform& transform, float angle, const glm::
     transform.rotation = delta * transform.rotation;
 }
 
+glm::mat4 TransformSystem::getInterpolatedTransformMatrix(const Transform& transform, float alpha) {
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::translate(model, glm::mix(transform.oldPosition, transform.position, alpha));
+    model *= glm::mat4_cast(transform.rotation);
+    model = glm::scale(model, transform.scale);
+    return model;
+}
+
 glm::mat4 TransformSystem::getTransformMatrix(const Transform& transform) {
     glm::mat4 model = glm::mat4(1.0f);
     model = glm::translate(model, transform.position);
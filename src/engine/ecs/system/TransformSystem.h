@@ -15,4 +15,6 @@ public:
     static void LocalRotate(Transform& transform, float angle, const glm::vec3& axis);
     static void WorldRotate(Transform& transform, float angle, const glm::vec3& axis);
     static glm::mat4 getTransformMatrix(const Transform& transform);
+    // Model matrix with the position blended from oldPosition (alpha 0) to position (alpha 1).
+    static glm::mat4 getInterpolatedTransformMatrix(const Transform& transform, float alpha);
 };
@@ -16,41 +16,49 @@
 
 Entity* DuckFactory::createDuck(World& world, const glm::vec3& position, float speed) {
     auto& entity = world.EntityManager.CreateEntity(world);
+    setupDuck(world, entity, position, speed);
+    return &entity;
+}
+
+void DuckFactory::setupDuck(World& world, Entity& entity, const glm::vec3& position, float speed) {
+
+    // Add components. Every add moves the entity to another archetype, so references are fetched once the
+    // signature is complete.
+    entity.addComponent<Transform>();
+    entity.addComponent<Velocity>();
+    entity.addComponent<StaticMeshComponent>();
+    entity.addComponent<BoxCollider>();
+    entity.addComponent<DebugDrawable>();
+    entity.addComponent<DuckComponent>();
+    entity.addComponent<HealthComponent>();
+    entity.addComponent<BoundsComponent>();
+    entity.addComponent<ScoreValueComponent>();
 
-    // Add components
-    auto& transform = entity.addComponent<Transform>();
+    auto& transform = entity.getComponent<Transform>();
     transform.position = position;
+    transform.oldPosition = position; // Otherwise the first rendered frame interpolates in from the origin
     transform.scale = glm::vec3(10.0f);
 
-    auto& velocity = entity.addComponent<Velocity>();
+    auto& velocity = entity.getComponent<Velocity>();
     velocity.Speed = speed;
 
-    auto& staticMesh = entity.addComponent<StaticMeshComponent>();
+    auto& staticMesh = entity.getComponent<StaticMeshComponent>();
     staticMesh.Mesh = ResourceManager::Get().GetStaticMesh("duck.obj");
     staticMesh.material = ResourceManager::Get().GetMaterial("duck");
 
-    auto& collider = entity.addComponent<BoxCollider>();
+    auto& collider = entity.getComponent<BoxCollider>();
     collider.size = staticMesh.Mesh->getSize(); // Store unscaled size (CollisionSystem will apply transform.scale)
     collider.center = staticMesh.Mesh->getCenter();
 
     // Adjust center offset based on unscaled size
     collider.center.y += (collider.size.y * transform.scale.y) / 2.0f;
 
-    entity.addComponent<DebugDrawable>();
-    entity.addComponent<DuckComponent>();
-    entity.addComponent<HealthComponent>();
-    
-    auto& bounds = entity.addComponent<BoundsComponent>();
+    auto& bounds = entity.getComponent<BoundsComponent>();
     bounds.spawnPosition = position;
 
-    entity.addComponent<ScoreValueComponent>();
-
     // Set random flight path
     TransformSystem::LocalRotate(transform, -45.0f, glm::vec3(1.0f, 0.0f, 0.0f));
     float randomAngle = rand() % 360;
     glm::quat rotation = glm::quat(glm::vec3(glm::radians(-45.0f), glm::radians(randomAngle), 0.0f));
     velocity.Direction = rotation * glm::vec3(0.0f, 0.0f, 10.0f);
-
-
-    return &entity;
 }
@@ -8,4 +8,7 @@ class Entity;
 class DuckFactory {
 public:
     static Entity* createDuck(World& world, const glm::vec3& position, float speed);
+
+    // Adds and initializes the duck components on an existing entity.
+    static void setupDuck(World& world, Entity& entity, const glm::vec3& position, float speed);
 };
@@ -16,7 +16,7 @@ EnvironmentGenerator::EnvironmentGenerator(World& world, EntityManager& entityMa
     weightedDist = std::discrete_distribution<int>(weights.begin(), weights.end());
 }
 
-int EnvironmentGenerator::generate(float startingRadius, int startingDensity, int maxNumRings, float spaceBetweenRings, glm::vec3 center)
+int EnvironmentGenerator::generate(float startingRadius, int startingDensity, int maxNumRings, float spaceBetweenRings, glm::vec3 center, bool bSolidProps)
 {
     if (modelNamesWithWeights.empty()) return 0;
 
@@ -30,7 +30,7 @@ int EnvironmentGenerator::generate(float startingRadius, int startingDensity, in
         std::vector<glm::vec3> ringPoints = GenerateRingPoints(center, currentRadius, (i + 1) * startingDensity, 1.f, 0.f);
         for (auto& pos : ringPoints) {
             const std::string& randomModelName = modelNames[weightedDist(gen)];
-            entityManager.CreateEntityOfType<EnvironmentEntity>(world, pos, randomModelName);
+            entityManager.CreateEntityOfType<EnvironmentEntity>(world, pos, randomModelName, bSolidProps);
             ++spawnedNumEntities;
         }
         currentRadius += spaceBetweenRings;
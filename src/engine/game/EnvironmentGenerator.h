@@ -21,8 +21,9 @@ public:
                                  {"rock_cluster_5.obj", 1.f},
                                  {"tree_stump_2.obj", 5.f}});
 
+    // bSolidProps gives every prop a collider (see EnvironmentEntity).
     int generate(float startingRadius, int startingDensity, int maxNumRings,
-                 float spaceBetweenRings, glm::vec3 center);
+                 float spaceBetweenRings, glm::vec3 center, bool bSolidProps = false);
 
 private:
     World& world;
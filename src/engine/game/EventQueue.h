@@ -2,7 +2,10 @@
 // Created by Nathan on 2025-11-30.
 //
 #pragma once
+#include <cstdint>
+#include <tuple>
 #include <vector>
+#include "glm/glm.hpp"
 
 struct DuckShotEvent {
     int duckId;
@@ -30,11 +33,40 @@ struct GameOverEvent {
 
 struct StartGameEvent { };
 
+// Reported by CollisionSystem for every pair of solid colliders overlapping after a fixed step.
+struct ContactEvent {
+    std::uint64_t entityA; // EntityID
+    std::uint64_t entityB;
+    glm::vec3 normal;      // Points from A towards B along the axis of least penetration
+    float penetration;
+};
+
+// Reported by CollisionSystem for every fixed step a collider overlaps one flagged isTrigger.
+struct TriggerEvent {
+    std::uint64_t triggerEntity;
+    std::uint64_t otherEntity;
+};
+
+// One queue per event type. Each EventQueue owns its queues, so CollisionSystem's contacts and GameStateSystem's
+// game events are kept and cleared independently.
 class EventQueue {
+    std::tuple<std::vector<DuckShotEvent>,
+               std::vector<DuckEscapedEvent>,
+               std::vector<BulletFiredEvent>,
+               std::vector<RoundStartEvent>,
+               std::vector<GameOverEvent>,
+               std::vector<StartGameEvent>,
+               std::vector<ContactEvent>,
+               std::vector<TriggerEvent>> queues;
+
     template<typename T>
-    static std::vector<T>& getQueue() {
-        static std::vector<T> queue;
-        return queue;
+    std::vector<T>& getQueue() {
+        return std::get<std::vector<T>>(queues);
+    }
+
+    template<typename T>
+    const std::vector<T>& getQueue() const {
+        return std::get<std::vector<T>>(queues);
     }
 
 public:
@@ -53,11 +85,12 @@ public:
         return !getQueue<T>().empty();
     }
 
+    template<typename T>
+    void clearQueue() {
+        getQueue<T>().clear();
+    }
+
     void clear() {
-        getQueue<DuckShotEvent>().clear();
-        getQueue<DuckEscapedEvent>().clear();
-        getQueue<BulletFiredEvent>().clear();
-        getQueue<RoundStartEvent>().clear();
-        getQueue<GameOverEvent>().clear();
+        std::apply([](auto&... queue) { (queue.clear(), ...); }, queues);
     }
 };
\ No newline at end of file
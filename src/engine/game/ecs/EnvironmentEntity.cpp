@@ -3,12 +3,32 @@
 #include "../../core/managers/ResourceManager.h"
 #include "../../ecs/components/StaticMeshComponent.h"
 #include "../../ecs/components/Transform.h"
+#include "../../ecs/components/BoxCollider.h"
+#include "../../ecs/system/TransformSystem.h"
+#include "../../renderer/Frustum.h"
 
-EnvironmentEntity::EnvironmentEntity(World &world, glm::vec3 &position, const std::string &modelName)
+EnvironmentEntity::EnvironmentEntity(World &world, glm::vec3 &position, const std::string &modelName, bool bSolid)
     : Entity(world) {
     auto& transform = addComponent<Transform>(position, glm::vec3(0.0f, 0.0f, 0.0f),
                                               glm::vec3(1.f,1.f,1.f));
     auto& staticMeshComponent = addComponent<StaticMeshComponent>();
     staticMeshComponent.Mesh = ResourceManager::Get().GetStaticMesh(modelName);
     staticMeshComponent.material = ResourceManager::Get().GetMaterial("env");
+
+    if (!bSolid) return;
+
+    // Solid props never move, so their collider lives in the CollisionSystem's static BVH.
+    // The collider is centered at position + center and scaled by the Transform, so the world box of the mesh
+    // is turned back into those terms.
+    glm::vec3 worldMin, worldMax;
+    transformAABB(TransformSystem::getTransformMatrix(transform), staticMeshComponent.Mesh->getMinBounds(),
+                  staticMeshComponent.Mesh->getMaxBounds(), worldMin, worldMax);
+    glm::vec3 size = (worldMax - worldMin) / transform.scale;
+    glm::vec3 center = (worldMin + worldMax) * 0.5f - transform.position;
+
+    // Adding the collider moves the entity to another archetype, so transform and staticMeshComponent dangle after this.
+    auto& collider = addComponent<BoxCollider>();
+    collider.size = size;
+    collider.center = center;
+    collider.isStatic = true;
 }
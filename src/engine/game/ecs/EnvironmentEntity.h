@@ -5,5 +5,6 @@
 
 class EnvironmentEntity : public Entity {
 public:
-    EnvironmentEntity(World& world, glm::vec3& position, const std::string& modelName);
+    // Solid props get a static BoxCollider around their mesh, so they block shots, raycasts and ducks.
+    EnvironmentEntity(World& world, glm::vec3& position, const std::string& modelName, bool bSolid = false);
 };
@@ -18,13 +18,15 @@ void DuckDeathSystem::update(World& world, float deltaTime) {
     Entity* gameState = world.getGameStateEntity();
     if (!gameState) return;
 
+    EntityCommandBuffer& commands = world.EntityManager.GetCommandBuffer();
+
     for (auto* duck : ducks) {
         auto& health = duck->getComponent<HealthComponent>();
 
         // If the duck just died, apply death effects
         if (health.isDead && !health.isCooked) {
             health.isCooked = true;
-            handleDuckDeath(*duck);
+            handleDuckDeath(*duck, commands);
 
             // Update game state (score, UI, etc.)
             GameStateSystem::hitDuck(*gameState);
@@ -32,21 +34,21 @@ void DuckDeathSystem::update(World& world, float deltaTime) {
     }
 }
 
-void DuckDeathSystem::handleDuckDeath(Entity& duck) {
+void DuckDeathSystem::handleDuckDeath(Entity& duck, EntityCommandBuffer& commands) {
     // Play duck death sound
     AudioManager::Get().PlaySound("quack");
 
     std::cout << "Duck Died" << std::endl;
 
-    // Apply visual transformation: duck -> turkey
-    if (duck.hasComponent<StaticMeshComponent>() && duck.hasComponent<Transform>()) {
-        auto& mesh = duck.getComponent<StaticMeshComponent>();
-        auto& transform = duck.getComponent<Transform>();
-
+    // Apply visual transformation: duck -> turkey. Applied at the sync point on the main thread, which also
+    // keeps the turkey's first load (GL) there.
+    commands.editComponent<StaticMeshComponent>(duck.getID(), [](StaticMeshComponent& mesh) {
         mesh.Mesh = ResourceManager::Get().GetStaticMesh("turkey.obj");
         mesh.material = ResourceManager::Get().GetMaterial("turkey");
+    });
 
-        // Scale down the turkey model to match the duck size (turkey model is larger)
+    // Scale down the turkey model to match the duck size (turkey model is larger)
+    commands.editComponent<Transform>(duck.getID(), [](Transform& transform) {
         transform.scale = glm::vec3(2.0f);
-    }
+    });
 }
@@ -2,6 +2,7 @@
 
 class World;
 class Entity;
+class EntityCommandBuffer;
 
 /**
  * Game-specific system that handles duck death visual effects.
@@ -13,6 +14,6 @@ public:
     // Updates all dead ducks, applying visual transformations. This runs each frame to catch newly-killed ducks and apply the turkey model.
     void update(World& world, float deltaTime);
 
-    // Handles the visual transformation when a duck dies. Changes the duck model to a turkey and updates scale.
-    static void handleDuckDeath(Entity& duck);
+    // Handles the visual transformation when a duck dies. Queues the change to a turkey model and its scale.
+    static void handleDuckDeath(Entity& duck, EntityCommandBuffer& commands);
 };
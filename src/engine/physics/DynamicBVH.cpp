@@ -0,0 +1,285 @@
+#include "DynamicBVH.h"
+
+namespace Physics {
+    int DynamicBVH::createProxy(const AABB& box, std::uint64_t userData)
+    {
+        int proxyId = allocateNode();
+        Node& node = nodes[proxyId];
+        node.box = box.expanded(margin);
+        node.userData = userData;
+        node.height = 0;
+
+        insertLeaf(proxyId);
+        ++proxyCount;
+        return proxyId;
+    }
+
+    void DynamicBVH::destroyProxy(int proxyId)
+    {
+        assert(nodes[proxyId].isLeaf());
+
+        removeLeaf(proxyId);
+        freeNode(proxyId);
+        --proxyCount;
+    }
+
+    bool DynamicBVH::moveProxy(int proxyId, const AABB& box)
+    {
+        const AABB& fatBox = nodes[proxyId].box;
+
+        // Also reinsert when the fat box is far bigger than needed (a duck shrinking into a turkey), since a
+        // loose box makes every query descend into this leaf for nothing.
+        if (fatBox.contains(box) && box.expanded(4.0f * margin).contains(fatBox)) {
+            return false;
+        }
+
+        removeLeaf(proxyId);
+        nodes[proxyId].box = box.expanded(margin);
+        insertLeaf(proxyId);
+        return true;
+    }
+
+    void DynamicBVH::clear()
+    {
+        nodes.clear();
+        root = NULL_NODE;
+        freeList = NULL_NODE;
+        proxyCount = 0;
+    }
+
+    int DynamicBVH::allocateNode()
+    {
+        int nodeId;
+        if (freeList != NULL_NODE) {
+            nodeId = freeList;
+            freeList = nodes[nodeId].nextFree;
+        } else {
+            nodeId = static_cast<int>(nodes.size());
+            nodes.emplace_back();
+        }
+
+        nodes[nodeId] = Node{};
+        return nodeId;
+    }
+
+    void DynamicBVH::freeNode(int nodeId)
+    {
+        nodes[nodeId].height = -1;
+        nodes[nodeId].nextFree = freeList;
+        freeList = nodeId;
+    }
+
+    void DynamicBVH::insertLeaf(int leaf)
+    {
+        if (root == NULL_NODE) {
+            root = leaf;
+            nodes[root].parent = NULL_NODE;
+            return;
+        }
+
+        // Walk down towards the sibling whose merge with the leaf adds the least surface area to the tree.
+        AABB leafBox = nodes[leaf].box;
+        int index = root;
+        while (!nodes[index].isLeaf()) {
+            const Node& node = nodes[index];
+
+            float area = node.box.surfaceArea();
+            float combinedArea = AABB::merge(node.box, leafBox).surfaceArea();
+
+            // Cost of making a new parent for this node and the leaf, and the cost pushed down to the children.
+            float cost = 2.0f * combinedArea;
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](int child) {
+                const Node& childNode = nodes[child];
+                float mergedArea = AABB::merge(leafBox, childNode.box).surfaceArea();
+                if (childNode.isLeaf()) {
+                    return mergedArea + inheritanceCost;
+                }
+                return mergedArea - childNode.box.surfaceArea() + inheritanceCost;
+            };
+
+            float cost1 = descendCost(node.child1);
+            float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) break;
+
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        int sibling = index;
+        int newParent = allocateNode();
+        int oldParent = nodes[sibling].parent;
+
+        Node& parentNode = nodes[newParent];
+        parentNode.parent = oldParent;
+        parentNode.box = AABB::merge(leafBox, nodes[sibling].box);
+        parentNode.height = nodes[sibling].height + 1;
+        parentNode.child1 = sibling;
+        parentNode.child2 = leaf;
+
+        if (oldParent != NULL_NODE) {
+            if (nodes[oldParent].child1 == sibling) {
+                nodes[oldParent].child1 = newParent;
+            } else {
+                nodes[oldParent].child2 = newParent;
+            }
+        } else {
+            root = newParent;
+        }
+
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+
+        refitAncestors(nodes[leaf].parent);
+    }
+
+    void DynamicBVH::removeLeaf(int leaf)
+    {
+        if (leaf == root) {
+            root = NULL_NODE;
+            return;
+        }
+
+        int parent = nodes[leaf].parent;
+        int grandParent = nodes[parent].parent;
+        int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+        if (grandParent != NULL_NODE) {
+            // The sibling takes the parent's place.
+            if (nodes[grandParent].child1 == parent) {
+                nodes[grandParent].child1 = sibling;
+            } else {
+                nodes[grandParent].child2 = sibling;
+            }
+            nodes[sibling].parent = grandParent;
+            freeNode(parent);
+
+            refitAncestors(grandParent);
+        } else {
+            root = sibling;
+            nodes[sibling].parent = NULL_NODE;
+            freeNode(parent);
+        }
+    }
+
+    void DynamicBVH::refitAncestors(int nodeId)
+    {
+        int index = nodeId;
+        while (index != NULL_NODE) {
+            index = balance(index);
+
+            Node& node = nodes[index];
+            const Node& child1 = nodes[node.child1];
+            const Node& child2 = nodes[node.child2];
+
+            node.height = 1 + std::max(child1.height, child2.height);
+            node.box = AABB::merge(child1.box, child2.box);
+
+            index = node.parent;
+        }
+    }
+
+    // Rotates the taller child of A up when A's subtrees differ in height by more than one.
+    // Returns the node now at A's old position.
+    int DynamicBVH::balance(int iA)
+    {
+        Node& A = nodes[iA];
+        if (A.isLeaf() || A.height < 2) {
+            return iA;
+        }
+
+        int iB = A.child1;
+        int iC = A.child2;
+        Node& B = nodes[iB];
+        Node& C = nodes[iC];
+
+        int heightDifference = C.height - B.height;
+
+        if (heightDifference > 1) {
+            // Rotate C up.
+            int iF = C.child1;
+            int iG = C.child2;
+            Node& F = nodes[iF];
+            Node& G = nodes[iG];
+
+            C.child1 = iA;
+            C.parent = A.parent;
+            A.parent = iC;
+
+            if (C.parent != NULL_NODE) {
+                if (nodes[C.parent].child1 == iA) {
+                    nodes[C.parent].child1 = iC;
+                } else {
+                    nodes[C.parent].child2 = iC;
+                }
+            } else {
+                root = iC;
+            }
+
+            if (F.height > G.height) {
+                C.child2 = iF;
+                A.child2 = iG;
+                G.parent = iA;
+                A.box = AABB::merge(B.box, G.box);
+                C.box = AABB::merge(A.box, F.box);
+                A.height = 1 + std::max(B.height, G.height);
+                C.height = 1 + std::max(A.height, F.height);
+            } else {
+                C.child2 = iG;
+                A.child2 = iF;
+                F.parent = iA;
+                A.box = AABB::merge(B.box, F.box);
+                C.box = AABB::merge(A.box, G.box);
+                A.height = 1 + std::max(B.height, F.height);
+                C.height = 1 + std::max(A.height, G.height);
+            }
+
+            return iC;
+        }
+
+        if (heightDifference < -1) {
+            // Rotate B up.
+            int iD = B.child1;
+            int iE = B.child2;
+            Node& D = nodes[iD];
+            Node& E = nodes[iE];
+
+            B.child1 = iA;
+            B.parent = A.parent;
+            A.parent = iB;
+
+            if (B.parent != NULL_NODE) {
+                if (nodes[B.parent].child1 == iA) {
+                    nodes[B.parent].child1 = iB;
+                } else {
+                    nodes[B.parent].child2 = iB;
+                }
+            } else {
+                root = iB;
+            }
+
+            if (D.height > E.height) {
+                B.child2 = iD;
+                A.child1 = iE;
+                E.parent = iA;
+                A.box = AABB::merge(C.box, E.box);
+                B.box = AABB::merge(A.box, D.box);
+                A.height = 1 + std::max(C.height, E.height);
+                B.height = 1 + std::max(A.height, D.height);
+            } else {
+                B.child2 = iE;
+                A.child1 = iD;
+                D.parent = iA;
+                A.box = AABB::merge(C.box, D.box);
+                B.box = AABB::merge(A.box, E.box);
+                A.height = 1 + std::max(C.height, D.height);
+                B.height = 1 + std::max(A.height, E.height);
+            }
+
+            return iB;
+        }
+
+        return iA;
+    }
+}
@@ -0,0 +1,201 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace Physics {
+    struct AABB {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+
+        bool contains(const AABB& other) const {
+            return glm::all(glm::lessThanEqual(min, other.min)) && glm::all(glm::greaterThanEqual(max, other.max));
+        }
+
+        bool overlaps(const AABB& other) const {
+            return min.x <= other.max.x && max.x >= other.min.x &&
+                   min.y <= other.max.y && max.y >= other.min.y &&
+                   min.z <= other.max.z && max.z >= other.min.z;
+        }
+
+        float surfaceArea() const {
+            glm::vec3 d = max - min;
+            return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+        }
+
+        AABB expanded(float amount) const {
+            return AABB{min - glm::vec3(amount), max + glm::vec3(amount)};
+        }
+
+        static AABB merge(const AABB& a, const AABB& b) {
+            return AABB{glm::min(a.min, b.min), glm::max(a.max, b.max)};
+        }
+    };
+
+    // Dynamic AABB tree. Leaves store a "fat" box grown by a margin, so a moving object is only reinserted once
+    // it leaves that box. Inserts pick the sibling with the lowest surface-area cost and rotations keep the tree
+    // balanced. Queries are read-only and may run on several threads at once, as long as nothing modifies the tree.
+    class DynamicBVH {
+    public:
+        static constexpr int NULL_NODE = -1;
+
+        explicit DynamicBVH(float margin = 0.0f) : margin(margin) {}
+
+        int createProxy(const AABB& box, std::uint64_t userData);
+        void destroyProxy(int proxyId);
+
+        // Returns true if the proxy left its fat box (or the fat box got much too large) and was reinserted.
+        bool moveProxy(int proxyId, const AABB& box);
+
+        std::uint64_t getUserData(int proxyId) const { return nodes[proxyId].userData; }
+        const AABB& getFatAABB(int proxyId) const { return nodes[proxyId].box; }
+        int getProxyCount() const { return proxyCount; }
+        int getHeight() const { return root == NULL_NODE ? 0 : nodes[root].height; }
+
+        void clear();
+
+        // Calls callback(proxyId) for every leaf whose fat box overlaps box.
+        template <typename Func>
+        void queryAABB(const AABB& box, Func&& callback) const;
+
+        // Calls callback(proxyId, maxDistance) for every leaf whose fat box the ray enters within maxDistance,
+        // nearer subtrees first. The callback returns the distance of the hit it confirmed, or the maxDistance
+        // it was given to keep searching; subtrees starting past the returned distance are skipped.
+        template <typename Func>
+        void raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Func&& callback) const;
+
+    private:
+        // AVL balancing keeps the height below 1.44 * log2(n), far from this limit.
+        static constexpr int STACK_CAPACITY = 128;
+
+        struct Node {
+            AABB box;
+            std::uint64_t userData = 0;
+            int parent = NULL_NODE;
+            int child1 = NULL_NODE;
+            int child2 = NULL_NODE;
+            // Leaves have height 0, free nodes -1.
+            int height = -1;
+            int nextFree = NULL_NODE;
+
+            bool isLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        std::vector<Node> nodes;
+        int root = NULL_NODE;
+        int freeList = NULL_NODE;
+        int proxyCount = 0;
+        float margin;
+
+        int allocateNode();
+        void freeNode(int nodeId);
+        void insertLeaf(int leaf);
+        void removeLeaf(int leaf);
+        void refitAncestors(int nodeId);
+        int balance(int nodeId);
+
+        // Slab test matching raycastAABB, so the tree never culls a box the exact test would hit.
+        static bool rayEntersBox(const AABB& box, const glm::vec3& origin, const glm::vec3& direction,
+                                 float maxDistance, float& entryDistance);
+    };
+
+    inline bool DynamicBVH::rayEntersBox(const AABB& box, const glm::vec3& origin, const glm::vec3& direction,
+                                         float maxDistance, float& entryDistance)
+    {
+        float tMin = 0.0f;
+        float tMax = maxDistance;
+
+        for (int i = 0; i < 3; ++i) {
+            if (std::abs(direction[i]) < 0.0001f) {
+                if (origin[i] < box.min[i] || origin[i] > box.max[i]) return false;
+            } else {
+                float t1 = (box.min[i] - origin[i]) / direction[i];
+                float t2 = (box.max[i] - origin[i]) / direction[i];
+                if (t1 > t2) std::swap(t1, t2);
+
+                tMin = std::max(tMin, t1);
+                tMax = std::min(tMax, t2);
+                if (tMin > tMax) return false;
+            }
+        }
+
+        entryDistance = tMin;
+        return true;
+    }
+
+    template <typename Func>
+    void DynamicBVH::queryAABB(const AABB& box, Func&& callback) const
+    {
+        if (root == NULL_NODE) return;
+
+        int stack[STACK_CAPACITY];
+        int stackSize = 0;
+        stack[stackSize++] = root;
+
+        while (stackSize > 0) {
+            const Node& node = nodes[stack[--stackSize]];
+            if (!node.box.overlaps(box)) continue;
+
+            if (node.isLeaf()) {
+                callback(static_cast<int>(&node - nodes.data()));
+            } else {
+                assert(stackSize + 2 <= STACK_CAPACITY);
+                stack[stackSize++] = node.child1;
+                stack[stackSize++] = node.child2;
+            }
+        }
+    }
+
+    template <typename Func>
+    void DynamicBVH::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Func&& callback) const
+    {
+        if (root == NULL_NODE) return;
+
+        float entry = 0.0f;
+        if (!rayEntersBox(nodes[root].box, origin, direction, maxDistance, entry)) return;
+
+        struct Entry {
+            int node;
+            float distance;
+        };
+        Entry stack[STACK_CAPACITY];
+        int stackSize = 0;
+        stack[stackSize++] = {root, entry};
+
+        while (stackSize > 0) {
+            Entry current = stack[--stackSize];
+            // A closer hit may have been found since this subtree was pushed.
+            if (current.distance > maxDistance) continue;
+
+            const Node& node = nodes[current.node];
+            if (node.isLeaf()) {
+                maxDistance = callback(current.node, maxDistance);
+                continue;
+            }
+
+            float entry1 = 0.0f;
+            float entry2 = 0.0f;
+            bool bHit1 = rayEntersBox(nodes[node.child1].box, origin, direction, maxDistance, entry1);
+            bool bHit2 = rayEntersBox(nodes[node.child2].box, origin, direction, maxDistance, entry2);
+
+            assert(stackSize + 2 <= STACK_CAPACITY);
+            // Push the farther child first so the nearer one is visited first and tightens maxDistance early.
+            if (bHit1 && bHit2) {
+                if (entry1 <= entry2) {
+                    stack[stackSize++] = {node.child2, entry2};
+                    stack[stackSize++] = {node.child1, entry1};
+                } else {
+                    stack[stackSize++] = {node.child1, entry1};
+                    stack[stackSize++] = {node.child2, entry2};
+                }
+            } else if (bHit1) {
+                stack[stackSize++] = {node.child1, entry1};
+            } else if (bHit2) {
+                stack[stackSize++] = {node.child2, entry2};
+            }
+        }
+    }
+}
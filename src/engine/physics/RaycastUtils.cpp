@@ -3,6 +3,223 @@
 #include <cfloat>
 #include <cmath>
 
+#if defined(__GNUC__) && defined(__x86_64__)
+#define PHYSICS_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace {
+    // Same threshold raycastAABB uses to treat the ray as parallel to a slab.
+    constexpr float PARALLEL_EPSILON = 0.0001f;
+
+    // Per-ray data shared by all batch kernels. Whether an axis is parallel depends only on the ray, so the
+    // kernels branch once per axis instead of once per box.
+    struct BatchRay {
+        float origin[3];
+        float direction[3];
+        bool parallel[3];
+        const float* mins[3];
+        const float* maxs[3];
+    };
+
+    BatchRay makeBatchRay(const glm::vec3& rayOrigin, const glm::vec3& rayDir, const Physics::AABBBatch& boxes) {
+        BatchRay ray{};
+        for (int i = 0; i < 3; ++i) {
+            ray.origin[i] = rayOrigin[i];
+            ray.direction[i] = rayDir[i];
+            ray.parallel[i] = std::abs(rayDir[i]) < PARALLEL_EPSILON;
+        }
+        ray.mins[0] = boxes.minX.data(); ray.mins[1] = boxes.minY.data(); ray.mins[2] = boxes.minZ.data();
+        ray.maxs[0] = boxes.maxX.data(); ray.maxs[1] = boxes.maxY.data(); ray.maxs[2] = boxes.maxZ.data();
+        return ray;
+    }
+
+    float rayBoxDistance(const BatchRay& ray, std::size_t box) {
+        float tMin = 0.0f;
+        float tMax = FLT_MAX;
+
+        for (int i = 0; i < 3; ++i) {
+            float boxMin = ray.mins[i][box];
+            float boxMax = ray.maxs[i][box];
+
+            if (ray.parallel[i]) {
+                if (ray.origin[i] < boxMin || ray.origin[i] > boxMax) return FLT_MAX;
+            } else {
+                float t1 = (boxMin - ray.origin[i]) / ray.direction[i];
+                float t2 = (boxMax - ray.origin[i]) / ray.direction[i];
+                tMin = std::max(tMin, std::min(t1, t2));
+                tMax = std::min(tMax, std::max(t1, t2));
+                if (tMin > tMax) return FLT_MAX;
+            }
+        }
+
+        return tMin;
+    }
+
+    // Scalar loop over [begin, end), continuing the closest-hit search from bestIndex/bestDistance.
+    int raycastBatchScalarRange(const BatchRay& ray, std::size_t begin, std::size_t end,
+                                int bestIndex, float bestDistance, float* distances) {
+        for (std::size_t box = begin; box < end; ++box) {
+            float distance = rayBoxDistance(ray, box);
+            if (distances) distances[box] = distance;
+
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                bestIndex = static_cast<int>(box);
+            }
+        }
+        return bestIndex;
+    }
+
+#ifndef PHYSICS_X86_SIMD
+    int raycastBatchScalar(const BatchRay& ray, std::size_t count, float maxDistance, float* distances) {
+        return raycastBatchScalarRange(ray, 0, count, -1, maxDistance, distances);
+    }
+#else
+    // Picks the closest lane (lowest index on ties) out of the per-lane bests.
+    template <int LANES>
+    int reduceLanes(const float* laneDistances, const int* laneIndices, float& bestDistance) {
+        int bestIndex = -1;
+        for (int lane = 0; lane < LANES; ++lane) {
+            if (laneIndices[lane] < 0) continue;
+            if (laneDistances[lane] < bestDistance ||
+                (laneDistances[lane] == bestDistance && laneIndices[lane] < bestIndex)) {
+                bestDistance = laneDistances[lane];
+                bestIndex = laneIndices[lane];
+            }
+        }
+        return bestIndex;
+    }
+
+    int raycastBatchSSE(const BatchRay& ray, std::size_t count, float maxDistance, float* distances) {
+        const __m128 miss = _mm_set1_ps(FLT_MAX);
+        __m128 bestDistances = _mm_set1_ps(maxDistance);
+        __m128i bestIndices = _mm_set1_epi32(-1);
+        __m128i indices = _mm_setr_epi32(0, 1, 2, 3);
+
+        std::size_t box = 0;
+        for (; box + 4 <= count; box += 4) {
+            __m128 tMin = _mm_setzero_ps();
+            __m128 tMax = miss;
+            __m128 valid = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (int i = 0; i < 3; ++i) {
+                __m128 origin = _mm_set1_ps(ray.origin[i]);
+                __m128 boxMin = _mm_loadu_ps(ray.mins[i] + box);
+                __m128 boxMax = _mm_loadu_ps(ray.maxs[i] + box);
+
+                if (ray.parallel[i]) {
+                    valid = _mm_and_ps(valid, _mm_and_ps(_mm_cmpge_ps(origin, boxMin), _mm_cmple_ps(origin, boxMax)));
+                } else {
+                    __m128 direction = _mm_set1_ps(ray.direction[i]);
+                    __m128 t1 = _mm_div_ps(_mm_sub_ps(boxMin, origin), direction);
+                    __m128 t2 = _mm_div_ps(_mm_sub_ps(boxMax, origin), direction);
+                    tMin = _mm_max_ps(tMin, _mm_min_ps(t1, t2));
+                    tMax = _mm_min_ps(tMax, _mm_max_ps(t1, t2));
+                }
+            }
+
+            valid = _mm_and_ps(valid, _mm_cmple_ps(tMin, tMax));
+            __m128 distance = _mm_or_ps(_mm_and_ps(valid, tMin), _mm_andnot_ps(valid, miss));
+            if (distances) _mm_storeu_ps(distances + box, distance);
+
+            __m128 closer = _mm_cmplt_ps(distance, bestDistances);
+            bestDistances = _mm_or_ps(_mm_and_ps(closer, distance), _mm_andnot_ps(closer, bestDistances));
+            __m128i closerMask = _mm_castps_si128(closer);
+            bestIndices = _mm_or_si128(_mm_and_si128(closerMask, indices), _mm_andnot_si128(closerMask, bestIndices));
+            indices = _mm_add_epi32(indices, _mm_set1_epi32(4));
+        }
+
+        alignas(16) float laneDistances[4];
+        alignas(16) int laneIndices[4];
+        _mm_store_ps(laneDistances, bestDistances);
+        _mm_store_si128(reinterpret_cast<__m128i*>(laneIndices), bestIndices);
+
+        float bestDistance = maxDistance;
+        int bestIndex = reduceLanes<4>(laneDistances, laneIndices, bestDistance);
+        return raycastBatchScalarRange(ray, box, count, bestIndex, bestDistance, distances);
+    }
+
+    __attribute__((target("avx2")))
+    int raycastBatchAVX2(const BatchRay& ray, std::size_t count, float maxDistance, float* distances) {
+        const __m256 miss = _mm256_set1_ps(FLT_MAX);
+        __m256 bestDistances = _mm256_set1_ps(maxDistance);
+        __m256i bestIndices = _mm256_set1_epi32(-1);
+        __m256i indices = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        std::size_t box = 0;
+        for (; box + 8 <= count; box += 8) {
+            __m256 tMin = _mm256_setzero_ps();
+            __m256 tMax = miss;
+            __m256 valid = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+            for (int i = 0; i < 3; ++i) {
+                __m256 origin = _mm256_set1_ps(ray.origin[i]);
+                __m256 boxMin = _mm256_loadu_ps(ray.mins[i] + box);
+                __m256 boxMax = _mm256_loadu_ps(ray.maxs[i] + box);
+
+                if (ray.parallel[i]) {
+                    valid = _mm256_and_ps(valid, _mm256_and_ps(_mm256_cmp_ps(origin, boxMin, _CMP_GE_OQ),
+                                                               _mm256_cmp_ps(origin, boxMax, _CMP_LE_OQ)));
+                } else {
+                    __m256 direction = _mm256_set1_ps(ray.direction[i]);
+                    __m256 t1 = _mm256_div_ps(_mm256_sub_ps(boxMin, origin), direction);
+                    __m256 t2 = _mm256_div_ps(_mm256_sub_ps(boxMax, origin), direction);
+                    tMin = _mm256_max_ps(tMin, _mm256_min_ps(t1, t2));
+                    tMax = _mm256_min_ps(tMax, _mm256_max_ps(t1, t2));
+                }
+            }
+
+            valid = _mm256_and_ps(valid, _mm256_cmp_ps(tMin, tMax, _CMP_LE_OQ));
+            __m256 distance = _mm256_blendv_ps(miss, tMin, valid);
+            if (distances) _mm256_storeu_ps(distances + box, distance);
+
+            __m256 closer = _mm256_cmp_ps(distance, bestDistances, _CMP_LT_OQ);
+            bestDistances = _mm256_blendv_ps(bestDistances, distance, closer);
+            bestIndices = _mm256_blendv_epi8(bestIndices, indices, _mm256_castps_si256(closer));
+            indices = _mm256_add_epi32(indices, _mm256_set1_epi32(8));
+        }
+
+        alignas(32) float laneDistances[8];
+        alignas(32) int laneIndices[8];
+        _mm256_store_ps(laneDistances, bestDistances);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(laneIndices), bestIndices);
+        // The tail and the caller are SSE code; leaving the upper halves dirty makes every SSE instruction after
+        // this pay for it, and GCC skips the vzeroupper when it turns the tail into a jump.
+        _mm256_zeroupper();
+
+        float bestDistance = maxDistance;
+        int bestIndex = reduceLanes<8>(laneDistances, laneIndices, bestDistance);
+        return raycastBatchScalarRange(ray, box, count, bestIndex, bestDistance, distances);
+    }
+#endif
+
+    using BatchKernel = int (*)(const BatchRay&, std::size_t, float, float*);
+
+    struct BatchKernelChoice {
+        BatchKernel kernel;
+        const char* name;
+    };
+
+    BatchKernelChoice selectBatchKernel() {
+#ifdef PHYSICS_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return {raycastBatchAVX2, "avx2"};
+        }
+        // SSE2 is part of x86-64, so there is always at least this path.
+        return {raycastBatchSSE, "sse"};
+#else
+        return {raycastBatchScalar, "scalar"};
+#endif
+    }
+
+    const BatchKernelChoice& getBatchKernel() {
+        static const BatchKernelChoice choice = selectBatchKernel();
+        return choice;
+    }
+}
+
 namespace Physics {
     RaycastHit raycastAABB(
         const glm::vec3& rayOrigin,
@@ -60,6 +277,34 @@ namespace Physics {
         return result;
     }
 
+    void AABBBatch::add(const glm::vec3& min, const glm::vec3& max)
+    {
+        minX.push_back(min.x); minY.push_back(min.y); minZ.push_back(min.z);
+        maxX.push_back(max.x); maxY.push_back(max.y); maxZ.push_back(max.z);
+    }
+
+    void AABBBatch::clear()
+    {
+        minX.clear(); minY.clear(); minZ.clear();
+        maxX.clear(); maxY.clear(); maxZ.clear();
+    }
+
+    int raycastAABBBatch(
+        const glm::vec3& rayOrigin,
+        const glm::vec3& rayDir,
+        const AABBBatch& boxes,
+        float maxDistance,
+        float* distances)
+    {
+        BatchRay ray = makeBatchRay(rayOrigin, rayDir, boxes);
+        return getBatchKernel().kernel(ray, boxes.size(), maxDistance, distances);
+    }
+
+    const char* getRaycastBatchKernelName()
+    {
+        return getBatchKernel().name;
+    }
+
     RaycastHit raycastAABBWithCallbacks(
         const glm::vec3& rayOrigin,
         const glm::vec3& rayDir,
@@ -1,6 +1,8 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <cstddef>
 #include <functional>
+#include <vector>
 
 namespace Physics {
     struct RaycastHit {
@@ -24,6 +26,31 @@ namespace Physics {
         const glm::vec3& aabbMax
     );
 
+    // Boxes stored as separate coordinate arrays (SoA), the layout the batched ray test loads from.
+    struct AABBBatch {
+        std::vector<float> minX, minY, minZ;
+        std::vector<float> maxX, maxY, maxZ;
+
+        void add(const glm::vec3& min, const glm::vec3& max);
+        void clear();
+        std::size_t size() const { return minX.size(); }
+    };
+
+    // Tests one ray against every box in the batch, 8 or 4 boxes at a time with AVX2/SSE when the CPU has it.
+    // Distances match raycastAABB. If distances is not null it receives the hit distance of each box, or FLT_MAX
+    // for a miss. Returns the index of the closest box hit before maxDistance (first one on ties), or -1.
+    // Point and normal are not computed; run raycastAABB on the returned box when they are needed.
+    int raycastAABBBatch(
+        const glm::vec3& rayOrigin,
+        const glm::vec3& rayDir,
+        const AABBBatch& boxes,
+        float maxDistance,
+        float* distances = nullptr
+    );
+
+    // Which batch kernel the runtime dispatch picked: "avx2", "sse" or "scalar".
+    const char* getRaycastBatchKernelName();
+
     // Raycast with callbacks
     RaycastHit raycastAABBWithCallbacks(
         const glm::vec3& rayOrigin,
@@ -0,0 +1,145 @@
+#include "SpatialHashGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 21 bits per axis; cells further than a million cells from the origin wrap around, which only costs extra
+    // candidate pairs.
+    std::uint64_t packCell(const glm::ivec3& cell) {
+        constexpr std::uint64_t mask = (1u << 21) - 1;
+        return ((static_cast<std::uint64_t>(cell.x) & mask) << 42) |
+               ((static_cast<std::uint64_t>(cell.y) & mask) << 21) |
+               (static_cast<std::uint64_t>(cell.z) & mask);
+    }
+
+    std::uint32_t hashCell(std::uint64_t cellKey) {
+        cellKey ^= cellKey >> 33;
+        cellKey *= 0xff51afd7ed558ccdULL;
+        cellKey ^= cellKey >> 33;
+        return static_cast<std::uint32_t>(cellKey);
+    }
+}
+
+namespace Physics {
+    void SpatialHashGrid::clear(float size)
+    {
+        cellSize = std::max(size, 0.001f);
+        inverseCellSize = 1.0f / cellSize;
+        boxes.clear();
+        staticFlags.clear();
+    }
+
+    void SpatialHashGrid::insert(const AABB& box, bool bStatic)
+    {
+        boxes.push_back(box);
+        staticFlags.push_back(bStatic ? 1 : 0);
+    }
+
+    glm::ivec3 SpatialHashGrid::getCell(const glm::vec3& point) const
+    {
+        return glm::ivec3(glm::floor(point * inverseCellSize));
+    }
+
+    void SpatialHashGrid::findOverlappingPairs(std::vector<Pair>& pairs)
+    {
+        entries.clear();
+        oversizedBoxes.clear();
+        oversizedFlags.assign(boxes.size(), 0);
+
+        for (std::uint32_t box = 0; box < boxes.size(); ++box) {
+            glm::ivec3 minCell = getCell(boxes[box].min);
+            glm::ivec3 maxCell = getCell(boxes[box].max);
+
+            std::int64_t cellCount = (static_cast<std::int64_t>(maxCell.x) - minCell.x + 1) *
+                                     (static_cast<std::int64_t>(maxCell.y) - minCell.y + 1) *
+                                     (static_cast<std::int64_t>(maxCell.z) - minCell.z + 1);
+            if (cellCount > MAX_CELLS_PER_BOX) {
+                oversizedBoxes.push_back(box);
+                oversizedFlags[box] = 1;
+                continue;
+            }
+
+            for (int x = minCell.x; x <= maxCell.x; ++x) {
+                for (int y = minCell.y; y <= maxCell.y; ++y) {
+                    for (int z = minCell.z; z <= maxCell.z; ++z) {
+                        entries.push_back({packCell(glm::ivec3(x, y, z)), box});
+                    }
+                }
+            }
+        }
+
+        // Oversized boxes are kept out of the grid in a tree of their own, so pairing them costs a tree query
+        // per box rather than a test against every box.
+        if (!oversizedBoxes.empty()) {
+            oversizedTree.clear();
+            for (std::uint32_t oversized : oversizedBoxes) {
+                oversizedTree.createProxy(boxes[oversized], oversized);
+            }
+
+            for (std::uint32_t box = 0; box < boxes.size(); ++box) {
+                oversizedTree.queryAABB(boxes[box], [&](int proxyId) {
+                    auto oversized = static_cast<std::uint32_t>(oversizedTree.getUserData(proxyId));
+                    if (oversized == box) return;
+                    // Pairs of two oversized boxes come up from both sides; only the lower index reports them.
+                    if (oversizedFlags[box] && oversized < box) return;
+                    if (staticFlags[oversized] && staticFlags[box]) return;
+
+                    pairs.emplace_back(std::min(oversized, box), std::max(oversized, box));
+                });
+            }
+        }
+
+        if (entries.empty()) return;
+
+        // Counting sort of the entries into hash buckets, with at least twice as many buckets as entries.
+        std::size_t bucketCount = 1;
+        while (bucketCount < entries.size() * 2) bucketCount <<= 1;
+        std::size_t bucketMask = bucketCount - 1;
+
+        bucketStarts.assign(bucketCount + 1, 0);
+        for (const CellEntry& entry : entries) {
+            ++bucketStarts[(hashCell(entry.cellKey) & bucketMask) + 1];
+        }
+        for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+            bucketStarts[bucket + 1] += bucketStarts[bucket];
+        }
+
+        sortedEntries.resize(entries.size());
+        // Writing advances every bucket start to the bucket's end; shifting by one restores the starts.
+        for (const CellEntry& entry : entries) {
+            std::size_t bucket = hashCell(entry.cellKey) & bucketMask;
+            sortedEntries[bucketStarts[bucket]++] = entry;
+        }
+        for (std::size_t bucket = bucketCount; bucket > 0; --bucket) {
+            bucketStarts[bucket] = bucketStarts[bucket - 1];
+        }
+        bucketStarts[0] = 0;
+
+        for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+            std::uint32_t begin = bucketStarts[bucket];
+            std::uint32_t end = bucketStarts[bucket + 1];
+
+            for (std::uint32_t i = begin; i < end; ++i) {
+                const CellEntry& first = sortedEntries[i];
+
+                for (std::uint32_t j = i + 1; j < end; ++j) {
+                    const CellEntry& second = sortedEntries[j];
+                    // Different cells that hashed into the same bucket.
+                    if (first.cellKey != second.cellKey) continue;
+                    if (staticFlags[first.box] && staticFlags[second.box]) continue;
+
+                    const AABB& a = boxes[first.box];
+                    const AABB& b = boxes[second.box];
+                    if (!a.overlaps(b)) continue;
+
+                    // Boxes sharing several cells meet in each of them; only the cell holding the minimum corner
+                    // of their overlap reports the pair.
+                    if (packCell(getCell(glm::max(a.min, b.min))) != first.cellKey) continue;
+
+                    pairs.emplace_back(std::min(first.box, second.box), std::max(first.box, second.box));
+                }
+            }
+        }
+    }
+}
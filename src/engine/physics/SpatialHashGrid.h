@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "DynamicBVH.h"
+
+namespace Physics {
+    // Uniform-grid broadphase. Boxes are dropped into every cell they touch, cells are hashed into a table twice
+    // the number of entries and grouped with a counting sort, so building and pairing stay linear in the number
+    // of boxes as long as the cell size is close to a typical box size.
+    class SpatialHashGrid {
+    public:
+        using Pair = std::pair<std::uint32_t, std::uint32_t>;
+
+        // Starts a new frame. Boxes are referred to by the order they are inserted in.
+        void clear(float cellSize);
+
+        // Static boxes are never paired with each other.
+        void insert(const AABB& box, bool bStatic);
+
+        std::size_t size() const { return boxes.size(); }
+
+        // Appends every pair (a < b) of overlapping boxes exactly once.
+        void findOverlappingPairs(std::vector<Pair>& pairs);
+
+    private:
+        // Boxes covering more cells than this skip the grid, so one huge collider cannot flood it. They go into
+        // oversizedTree instead, which every box is queried against.
+        static constexpr std::int64_t MAX_CELLS_PER_BOX = 512;
+
+        struct CellEntry {
+            std::uint64_t cellKey;
+            std::uint32_t box;
+        };
+
+        float cellSize = 1.0f;
+        float inverseCellSize = 1.0f;
+
+        std::vector<AABB> boxes;
+        std::vector<std::uint8_t> staticFlags;
+
+        // Scratch buffers, kept between frames so steady state does not allocate.
+        std::vector<CellEntry> entries;
+        std::vector<CellEntry> sortedEntries;
+        std::vector<std::uint32_t> bucketStarts;
+        std::vector<std::uint32_t> oversizedBoxes;
+        std::vector<std::uint8_t> oversizedFlags;
+        DynamicBVH oversizedTree;
+
+        glm::ivec3 getCell(const glm::vec3& point) const;
+    };
+}
@@ -0,0 +1,28 @@
+#include "FrameUniforms.h"
+
+bool FrameUniforms::initialize() {
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Stays bound for the lifetime of the buffer; every program using the block reads from here
+    glBindBufferBase(GL_UNIFORM_BUFFER, BINDING, ubo);
+    return ubo != 0;
+}
+
+void FrameUniforms::update(const glm::mat4& view, const glm::mat4& projection, const glm::mat4& lightSpaceMatrix,
+                           const glm::vec3& viewPos) {
+    // Lets the lighting shaders turn a depth sample back into a world position (compact G-buffer)
+    glm::mat4 inverseViewProjection = glm::inverse(projection * view);
+    FrameData data{view, projection, lightSpaceMatrix, inverseViewProjection, glm::vec4(viewPos, 1.0f)};
+
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void FrameUniforms::cleanup() {
+    if (ubo) glDeleteBuffers(1, &ubo);
+    ubo = 0;
+}
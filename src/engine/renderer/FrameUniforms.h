@@ -0,0 +1,40 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+// Per-frame data every shader shares, uploaded once per frame into a uniform buffer instead of being set on each
+// shader separately. Shaders opt in by declaring the block exactly like this (std140 layout):
+//
+//     layout (std140) uniform FrameData {
+//         mat4 view;
+//         mat4 projection;
+//         mat4 lightSpaceMatrix;
+//         mat4 inverseViewProjection;
+//         vec3 viewPos;
+//     };
+//
+// Shader::loadFromFiles attaches the block to BINDING when a program declares it. LightManager owns the other
+// shared block, LightData.
+class FrameUniforms {
+public:
+    static constexpr GLuint BINDING = 0;
+    static constexpr const char* BLOCK_NAME = "FrameData";
+
+    bool initialize();
+    void update(const glm::mat4& view, const glm::mat4& projection, const glm::mat4& lightSpaceMatrix,
+                const glm::vec3& viewPos);
+    void cleanup();
+
+private:
+    // Mirrors the std140 block: mat4s are 64 bytes each and the vec3 is padded to 16.
+    struct FrameData {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 lightSpaceMatrix;
+        glm::mat4 inverseViewProjection;
+        glm::vec4 viewPos;
+    };
+    static_assert(sizeof(FrameData) == 272, "FrameData must match the std140 layout of the GLSL block");
+
+    GLuint ubo = 0;
+};
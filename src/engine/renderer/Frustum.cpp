@@ -0,0 +1,194 @@
+#include "Frustum.h"
+#include <cmath>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define FRUSTUM_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+Frustum Frustum::fromViewProjection(const glm::mat4& viewProjection) {
+    // Rows of the matrix; GLM stores columns, so row i is element i of every column
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; ++i) {
+        rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    }
+
+    // A point is inside when -w <= x, y, z <= w in clip space
+    Frustum frustum{};
+    frustum.planes[0] = rows[3] + rows[0]; // Left
+    frustum.planes[1] = rows[3] - rows[0]; // Right
+    frustum.planes[2] = rows[3] + rows[1]; // Bottom
+    frustum.planes[3] = rows[3] - rows[1]; // Top
+    frustum.planes[4] = rows[3] + rows[2]; // Near
+    frustum.planes[5] = rows[3] - rows[2]; // Far
+
+    for (glm::vec4& plane : frustum.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+bool Frustum::intersectsAABB(const glm::vec3& min, const glm::vec3& max) const {
+    for (const glm::vec4& plane : planes) {
+        // The corner furthest along the plane normal; if even that one is behind the plane, the whole box is
+        glm::vec3 corner(plane.x >= 0.0f ? max.x : min.x,
+                         plane.y >= 0.0f ? max.y : min.y,
+                         plane.z >= 0.0f ? max.z : min.z);
+        // Summed in the same order as the batch kernels, so both agree on boxes touching a plane
+        float distance = plane.w;
+        distance += plane.x * corner.x;
+        distance += plane.y * corner.y;
+        distance += plane.z * corner.z;
+        if (distance < 0.0f) return false;
+    }
+    return true;
+}
+
+void transformAABB(const glm::mat4& model, const glm::vec3& localMin, const glm::vec3& localMax,
+                   glm::vec3& worldMin, glm::vec3& worldMax) {
+    glm::vec3 center = glm::vec3(model * glm::vec4((localMin + localMax) * 0.5f, 1.0f));
+    glm::vec3 extent = (localMax - localMin) * 0.5f;
+
+    // Each world axis gets the extents of every local axis projected onto it
+    glm::vec3 worldExtent(0.0f);
+    for (int axis = 0; axis < 3; ++axis) {
+        worldExtent += glm::abs(glm::vec3(model[axis])) * extent[axis];
+    }
+
+    worldMin = center - worldExtent;
+    worldMax = center + worldExtent;
+}
+
+namespace {
+    // Per-plane data shared by all cull kernels. Which corner a plane tests depends only on the plane, so the
+    // kernels pick the min or max array once per plane instead of once per box.
+    struct CullPlane {
+        float normal[3];
+        float distance;
+        const float* corner[3];
+    };
+
+    struct CullPlanes {
+        CullPlane planes[6];
+    };
+
+    CullPlanes makeCullPlanes(const Frustum& frustum, const Physics::AABBBatch& boxes) {
+        CullPlanes cull{};
+        const float* mins[3] = {boxes.minX.data(), boxes.minY.data(), boxes.minZ.data()};
+        const float* maxs[3] = {boxes.maxX.data(), boxes.maxY.data(), boxes.maxZ.data()};
+
+        for (int p = 0; p < 6; ++p) {
+            const glm::vec4& plane = frustum.planes[p];
+            for (int i = 0; i < 3; ++i) {
+                cull.planes[p].normal[i] = plane[i];
+                cull.planes[p].corner[i] = plane[i] >= 0.0f ? maxs[i] : mins[i];
+            }
+            cull.planes[p].distance = plane.w;
+        }
+        return cull;
+    }
+
+    void cullScalarRange(const CullPlanes& cull, std::size_t begin, std::size_t end, std::uint8_t* visible) {
+        for (std::size_t box = begin; box < end; ++box) {
+            bool bInside = true;
+            for (const CullPlane& plane : cull.planes) {
+                float distance = plane.distance;
+                for (int i = 0; i < 3; ++i) {
+                    distance += plane.normal[i] * plane.corner[i][box];
+                }
+                if (distance < 0.0f) {
+                    bInside = false;
+                    break;
+                }
+            }
+            visible[box] = bInside ? 1 : 0;
+        }
+    }
+
+#ifndef FRUSTUM_X86_SIMD
+    void cullScalar(const CullPlanes& cull, std::size_t count, std::uint8_t* visible) {
+        cullScalarRange(cull, 0, count, visible);
+    }
+#else
+    void cullSSE(const CullPlanes& cull, std::size_t count, std::uint8_t* visible) {
+        std::size_t box = 0;
+        for (; box + 4 <= count; box += 4) {
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+
+            for (const CullPlane& plane : cull.planes) {
+                __m128 distance = _mm_set1_ps(plane.distance);
+                for (int i = 0; i < 3; ++i) {
+                    __m128 corner = _mm_loadu_ps(plane.corner[i] + box);
+                    distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.normal[i]), corner));
+                }
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, _mm_setzero_ps()));
+            }
+
+            int mask = _mm_movemask_ps(inside);
+            for (int lane = 0; lane < 4; ++lane) {
+                visible[box + lane] = (mask >> lane) & 1;
+            }
+        }
+        cullScalarRange(cull, box, count, visible);
+    }
+
+    __attribute__((target("avx2")))
+    void cullAVX2(const CullPlanes& cull, std::size_t count, std::uint8_t* visible) {
+        std::size_t box = 0;
+        for (; box + 8 <= count; box += 8) {
+            __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+            for (const CullPlane& plane : cull.planes) {
+                __m256 distance = _mm256_set1_ps(plane.distance);
+                for (int i = 0; i < 3; ++i) {
+                    __m256 corner = _mm256_loadu_ps(plane.corner[i] + box);
+                    distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(plane.normal[i]), corner));
+                }
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ));
+            }
+
+            int mask = _mm256_movemask_ps(inside);
+            for (int lane = 0; lane < 8; ++lane) {
+                visible[box + lane] = (mask >> lane) & 1;
+            }
+        }
+        // The tail and the caller are SSE code; GCC drops the vzeroupper when the tail call becomes a jump.
+        _mm256_zeroupper();
+        cullScalarRange(cull, box, count, visible);
+    }
+#endif
+
+    using CullKernel = void (*)(const CullPlanes&, std::size_t, std::uint8_t*);
+
+    struct CullKernelChoice {
+        CullKernel kernel;
+        const char* name;
+    };
+
+    CullKernelChoice selectCullKernel() {
+#ifdef FRUSTUM_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return {cullAVX2, "avx2"};
+        }
+        // SSE2 is part of x86-64, so there is always at least this path.
+        return {cullSSE, "sse"};
+#else
+        return {cullScalar, "scalar"};
+#endif
+    }
+
+    const CullKernelChoice& getCullKernel() {
+        static const CullKernelChoice choice = selectCullKernel();
+        return choice;
+    }
+}
+
+void cullAABBBatch(const Frustum& frustum, const Physics::AABBBatch& boxes, std::uint8_t* visible) {
+    if (boxes.size() == 0) return;
+    getCullKernel().kernel(makeCullPlanes(frustum, boxes), boxes.size(), visible);
+}
+
+const char* getFrustumCullKernelName() {
+    return getCullKernel().name;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include "../physics/RaycastUtils.h"
+
+// Six clip planes with normals pointing inwards, taken from a view-projection matrix. Works for perspective
+// cameras and for the orthographic light volume of the shadow map alike.
+struct Frustum {
+    glm::vec4 planes[6];
+
+    static Frustum fromViewProjection(const glm::mat4& viewProjection);
+
+    // Conservative: boxes near a corner of the frustum can pass without touching it, but no visible box is rejected.
+    bool intersectsAABB(const glm::vec3& min, const glm::vec3& max) const;
+};
+
+// World-space box around a local box moved by model (rotation and scale included).
+void transformAABB(const glm::mat4& model, const glm::vec3& localMin, const glm::vec3& localMax,
+                   glm::vec3& worldMin, glm::vec3& worldMax);
+
+// Writes 1 to visible[i] if box i intersects the frustum and 0 otherwise, testing 8 or 4 boxes at a time with
+// AVX2/SSE when the CPU has it. Same result as Frustum::intersectsAABB for every box.
+void cullAABBBatch(const Frustum& frustum, const Physics::AABBBatch& boxes, std::uint8_t* visible);
+
+// Which cull kernel the runtime dispatch picked: "avx2", "sse" or "scalar".
+const char* getFrustumCullKernelName();
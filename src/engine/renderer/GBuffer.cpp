@@ -3,7 +3,7 @@
 
 GBuffer::GBuffer()
     : fbo(0), gPosition(0), gNormal(0), gAlbedo(0), gMetallicRoughness(0),
-      depthBuffer(0), width(0), height(0) {
+      depthTexture(0), width(0), height(0), layout(GBufferLayout::STANDARD) {
 }
 
 GBuffer::~GBuffer() {
@@ -15,32 +15,40 @@ void GBuffer::cleanup() {
     if (gNormal) glDeleteTextures(1, &gNormal);
     if (gAlbedo) glDeleteTextures(1, &gAlbedo);
     if (gMetallicRoughness) glDeleteTextures(1, &gMetallicRoughness);
-    if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+    if (depthTexture) glDeleteTextures(1, &depthTexture);
     if (fbo) glDeleteFramebuffers(1, &fbo);
+    fbo = gPosition = gNormal = gAlbedo = gMetallicRoughness = depthTexture = 0;
 }
 
-bool GBuffer::initialize(int w, int h) {
+bool GBuffer::initialize(int w, int h, GBufferLayout gBufferLayout) {
     this->width = w;
     this->height = h;
+    this->layout = gBufferLayout;
 
     // Create framebuffer
     glGenFramebuffers(1, &fbo);
     glBindFramebuffer(GL_FRAMEBUFFER, fbo);
 
-    // Position texture (RGB16F for high precision)
-    glGenTextures(1, &gPosition);
-    glBindTexture(GL_TEXTURE_2D, gPosition);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gPosition, 0);
+    // Position texture (RGB16F for high precision); COMPACT rebuilds position from depth instead
+    if (layout == GBufferLayout::STANDARD) {
+        glGenTextures(1, &gPosition);
+        glBindTexture(GL_TEXTURE_2D, gPosition);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gPosition, 0);
+    }
 
-    // Normal texture (RGB16F)
+    // Normal texture (RGB16F, or RG16 octahedral for COMPACT)
     glGenTextures(1, &gNormal);
     glBindTexture(GL_TEXTURE_2D, gNormal);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, nullptr);
+    if (layout == GBufferLayout::COMPACT) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16, width, height, 0, GL_RG, GL_UNSIGNED_SHORT, nullptr);
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, nullptr);
+    }
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -67,20 +75,26 @@ bool GBuffer::initialize(int w, int h) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT3, GL_TEXTURE_2D, gMetallicRoughness, 0);
 
-    // Specify which color attachments we'll use
+    // Specify which color attachments we'll use. The outputs keep their locations in both layouts; COMPACT just
+    // discards the position output.
     GLenum attachments[] = {
-        GL_COLOR_ATTACHMENT0,
+        static_cast<GLenum>(layout == GBufferLayout::STANDARD ? GL_COLOR_ATTACHMENT0 : GL_NONE),
         GL_COLOR_ATTACHMENT1,
         GL_COLOR_ATTACHMENT2,
         GL_COLOR_ATTACHMENT3
     };
     glDrawBuffers(4, attachments);
 
-    // Depth renderbuffer
-    glGenRenderbuffers(1, &depthBuffer);
-    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT, width, height);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    // Depth-stencil texture, sampled for position in COMPACT. LightVolumes blits the depth into its own buffer of
+    // the same format rather than attaching this one.
+    glGenTextures(1, &depthTexture);
+    glBindTexture(GL_TEXTURE_2D, depthTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH24_STENCIL8, width, height, 0, GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
 
     // Check framebuffer completeness
     if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
@@ -90,7 +104,8 @@ bool GBuffer::initialize(int w, int h) {
     }
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    std::cout << "GBuffer initialized successfully (" << width << "x" << height << ")" << std::endl;
+    std::cout << "GBuffer initialized successfully (" << width << "x" << height
+              << (layout == GBufferLayout::COMPACT ? ", compact" : "") << ")" << std::endl;
     return true;
 }
 
@@ -101,8 +116,9 @@ void GBuffer::bindForWriting() {
 }
 
 void GBuffer::bindForReading() {
+    // Unit 0 holds whatever the lighting shaders rebuild position from (gPosition or gDepth)
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, gPosition);
+    glBindTexture(GL_TEXTURE_2D, layout == GBufferLayout::COMPACT ? depthTexture : gPosition);
     glActiveTexture(GL_TEXTURE1);
     glBindTexture(GL_TEXTURE_2D, gNormal);
     glActiveTexture(GL_TEXTURE2);
@@ -119,5 +135,5 @@ void GBuffer::resize(int w, int h) {
     if (w == width && h == height) return;
 
     cleanup();
-    initialize(w, h);
+    initialize(w, h, layout);
 }
\ No newline at end of file
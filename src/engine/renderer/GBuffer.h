@@ -3,12 +3,20 @@
 #include "Texture.h"
 #include <memory>
 
+// STANDARD stores world position and normal in two RGBA16F targets. COMPACT drops the position target (the lighting
+// shaders rebuild it from depth with the inverse view-projection) and stores octahedral-encoded normals in RG16,
+// which takes the G-buffer from 26 to 14 bytes per pixel including depth.
+enum class GBufferLayout {
+    STANDARD,
+    COMPACT
+};
+
 class GBuffer {
 public:
     GBuffer();
     ~GBuffer();
 
-    bool initialize(int width, int height);
+    bool initialize(int width, int height, GBufferLayout layout = GBufferLayout::STANDARD);
     void bindForWriting();
     void bindForReading();
     void unbind();
@@ -17,18 +25,23 @@ public:
     GLuint getNormalTexture() const { return gNormal; }
     GLuint getAlbedoTexture() const { return gAlbedo; }
     GLuint getMetallicRoughnessTexture() const { return gMetallicRoughness; }
-    GLuint getDepthTexture() const { return depthBuffer; }
+    GLuint getDepthTexture() const { return depthTexture; }
     GLuint getFramebuffer() const { return fbo; }
+    GBufferLayout getLayout() const { return layout; }
+    bool isCompact() const { return layout == GBufferLayout::COMPACT; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
 
 private:
     GLuint fbo;
-    GLuint gPosition;          // RGB: Position, A: unused
-    GLuint gNormal;            // RGB: Normal, A: unused
+    GLuint gPosition;          // RGB: Position, A: unused (STANDARD only)
+    GLuint gNormal;            // RGB: Normal, A: unused (COMPACT: RG octahedral normal)
     GLuint gAlbedo;            // RGB: Albedo, A: unused
     GLuint gMetallicRoughness; // R: Metallic, G: Roughness, BA: unused
-    GLuint depthBuffer;        // Depth renderbuffer
+    GLuint depthTexture;       // Depth-stencil, sampled for position in COMPACT
 
     int width, height;
+    GBufferLayout layout;
 
     void cleanup();
 };
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "GpuTimer.h"
+#include "../debug/Profiler.h"
+#include <algorithm>
+#include <iostream>
+
+GpuTimer::GpuTimer()
+    : frameIndex(0), activePass(-1), bInitialized(false) {
+}
+
+bool GpuTimer::initialize() {
+    // Drop errors left by earlier calls so only our own are caught
+    while (glGetError() != GL_NO_ERROR) {}
+
+    for (FrameQueries& frame : frames) {
+        glGenQueries(PASS_COUNT, frame.queries);
+    }
+
+    if (glGetError() != GL_NO_ERROR) {
+        std::cerr << "[GpuTimer] Failed to create timer queries" << std::endl;
+        cleanup();
+        return false;
+    }
+
+    bInitialized = true;
+    return true;
+}
+
+void GpuTimer::cleanup() {
+    for (FrameQueries& frame : frames) {
+        if (frame.queries[0]) glDeleteQueries(PASS_COUNT, frame.queries);
+        std::fill(std::begin(frame.queries), std::end(frame.queries), 0);
+        std::fill(std::begin(frame.bIssued), std::end(frame.bIssued), false);
+    }
+    bInitialized = false;
+}
+
+void GpuTimer::beginFrame() {
+    if (!bInitialized) return;
+
+    frameIndex = (frameIndex + 1) % QUERY_FRAMES;
+    collect(frames[frameIndex]);
+}
+
+void GpuTimer::beginPass(GpuPass pass) {
+    if (!bInitialized || activePass >= 0) return;
+
+    FrameQueries& frame = frames[frameIndex];
+    activePass = static_cast<int>(pass);
+    frame.submitTimestamps[activePass] = Profiler::readTimestamp();
+    frame.bIssued[activePass] = true;
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[activePass]);
+}
+
+void GpuTimer::endPass() {
+    if (activePass < 0) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    activePass = -1;
+}
+
+void GpuTimer::collect(FrameQueries& frame) {
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        if (!frame.bIssued[pass]) continue;
+        frame.bIssued[pass] = false;
+
+        // Still running after QUERY_FRAMES frames means the GPU is far behind; drop the sample rather than stall
+        GLint available = 0;
+        glGetQueryObjectiv(frame.queries[pass], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(frame.queries[pass], GL_QUERY_RESULT, &nanoseconds);
+
+        history[pass][historyNext[pass]] = static_cast<float>(nanoseconds) / 1.0e6f;
+        historyNext[pass] = (historyNext[pass] + 1) % HISTORY_FRAMES;
+        historyCount[pass] = std::min(historyCount[pass] + 1, HISTORY_FRAMES);
+
+        Profiler::recordGpuZone(getPassName(static_cast<GpuPass>(pass)), frame.submitTimestamps[pass], nanoseconds);
+    }
+}
+
+GpuTimer::PassStats GpuTimer::getStats(GpuPass pass) const {
+    int index = static_cast<int>(pass);
+    PassStats stats;
+    stats.samples = historyCount[index];
+    if (stats.samples == 0) return stats;
+
+    const float* samples = history[index];
+    stats.minMs = samples[0];
+    stats.maxMs = samples[0];
+    float total = 0.0f;
+    for (int i = 0; i < stats.samples; ++i) {
+        stats.minMs = std::min(stats.minMs, samples[i]);
+        stats.maxMs = std::max(stats.maxMs, samples[i]);
+        total += samples[i];
+    }
+    stats.avgMs = total / static_cast<float>(stats.samples);
+    return stats;
+}
+
+const char* GpuTimer::getPassName(GpuPass pass) {
+    switch (pass) {
+        case GpuPass::SHADOW:   return "Shadow";
+        case GpuPass::GEOMETRY: return "Geometry";
+        case GpuPass::LIGHTING: return "Lighting";
+        case GpuPass::SKYBOX:   return "Skybox";
+        case GpuPass::DEBUG:    return "Debug";
+        case GpuPass::UI:       return "UI";
+        default:                return "Unknown";
+    }
+}
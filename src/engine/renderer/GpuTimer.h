@@ -0,0 +1,65 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstdint>
+
+// Render passes of Engine::render, in the order they run.
+enum class GpuPass {
+    SHADOW,
+    GEOMETRY,
+    LIGHTING,
+    SKYBOX,
+    DEBUG,
+    UI,
+    COUNT
+};
+
+// Times each render pass on the GPU with a GL_TIME_ELAPSED query. Every frame in flight has its own set of
+// queries and a frame's results are only read when its queries come up for reuse QUERY_FRAMES frames later, so
+// reading them never waits on the GPU. Finished timings feed rolling min/avg/max stats and the profiler's GPU track.
+class GpuTimer {
+public:
+    static constexpr int PASS_COUNT = static_cast<int>(GpuPass::COUNT);
+    static constexpr int QUERY_FRAMES = 2;
+    // Frames the rolling stats cover, about two seconds at 60 fps.
+    static constexpr int HISTORY_FRAMES = 120;
+
+    struct PassStats {
+        float minMs = 0.0f;
+        float avgMs = 0.0f;
+        float maxMs = 0.0f;
+        int samples = 0;
+    };
+
+    GpuTimer();
+
+    bool initialize();
+    void cleanup();
+
+    // Call once per frame before the first pass.
+    void beginFrame();
+
+    // Passes cannot nest: GL allows one GL_TIME_ELAPSED query at a time.
+    void beginPass(GpuPass pass);
+    void endPass();
+
+    PassStats getStats(GpuPass pass) const;
+    static const char* getPassName(GpuPass pass);
+
+private:
+    struct FrameQueries {
+        GLuint queries[PASS_COUNT] = {};
+        std::uint64_t submitTimestamps[PASS_COUNT] = {};
+        bool bIssued[PASS_COUNT] = {};
+    };
+
+    FrameQueries frames[QUERY_FRAMES];
+    int frameIndex;
+    int activePass;
+    bool bInitialized;
+
+    float history[PASS_COUNT][HISTORY_FRAMES] = {};
+    int historyCount[PASS_COUNT] = {};
+    int historyNext[PASS_COUNT] = {};
+
+    void collect(FrameQueries& frame);
+};
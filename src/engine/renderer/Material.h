@@ -4,6 +4,7 @@
 
 #include "Shader.h"
 #include "Texture.h"
+#include "RenderResourceId.h"
 
 class Material {
 public:
@@ -25,7 +26,11 @@ public:
     void bind(Shader& shader, unsigned int startUnit = 0);
     void unbind();
 
+    std::uint32_t getRenderId() const { return renderId.get(); }
+
 private:
+    RenderResourceId<Material> renderId;
+
     std::unique_ptr<Texture> albedoMap;
     std::unique_ptr<Texture> normalMap;
     std::unique_ptr<Texture> metallicMap;
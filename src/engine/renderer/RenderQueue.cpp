@@ -0,0 +1,64 @@
+#include "RenderQueue.h"
+#include "Shader.h"
+#include "Material.h"
+#include "../core/model/StaticMesh.h"
+#include <algorithm>
+#include <cstring>
+
+void RenderQueue::clear() {
+    items.clear();
+    keys.clear();
+}
+
+void RenderQueue::submit(RenderPass pass, Shader* shader, Material* material, StaticMesh* mesh, const glm::mat4& model, float depth) {
+    constexpr std::uint64_t MAX_DEPTH = (1ull << DEPTH_BITS) - 1;
+    auto quantizedDepth = static_cast<std::uint64_t>(std::clamp(depth, 0.0f, 1.0f) * static_cast<float>(MAX_DEPTH));
+
+    std::uint64_t key = static_cast<std::uint64_t>(pass);
+    key = (key << SHADER_BITS) | maskId(shader->getRenderId(), SHADER_BITS);
+    key = (key << MATERIAL_BITS) | maskId(material->getRenderId(), MATERIAL_BITS);
+    key = (key << MESH_BITS) | maskId(mesh->getRenderId(), MESH_BITS);
+    key = (key << DEPTH_BITS) | quantizedDepth;
+
+    keys.push_back({key, static_cast<std::uint32_t>(items.size())});
+    items.push_back({pass, shader, material, mesh, model});
+}
+
+void RenderQueue::sort() {
+    constexpr int DIGIT_BITS = 8;
+    constexpr int DIGITS = 64 / DIGIT_BITS;
+    constexpr int BUCKETS = 1 << DIGIT_BITS;
+
+    std::size_t count = keys.size();
+    if (count < 2) return;
+    scratch.resize(count);
+
+    // Histograms of every digit in one pass over the keys
+    std::uint32_t histograms[DIGITS][BUCKETS];
+    std::memset(histograms, 0, sizeof(histograms));
+    for (const SortKey& sortKey : keys) {
+        for (int digit = 0; digit < DIGITS; ++digit) {
+            ++histograms[digit][(sortKey.key >> (digit * DIGIT_BITS)) & (BUCKETS - 1)];
+        }
+    }
+
+    for (int digit = 0; digit < DIGITS; ++digit) {
+        std::uint32_t* histogram = histograms[digit];
+        int shift = digit * DIGIT_BITS;
+
+        // A digit every key shares would leave the order unchanged; most of pass and shader bits are like that
+        if (histogram[(keys[0].key >> shift) & (BUCKETS - 1)] == count) continue;
+
+        std::uint32_t offset = 0;
+        for (int bucket = 0; bucket < BUCKETS; ++bucket) {
+            std::uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+
+        for (const SortKey& sortKey : keys) {
+            scratch[histogram[(sortKey.key >> shift) & (BUCKETS - 1)]++] = sortKey;
+        }
+        keys.swap(scratch);
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Shader;
+class Material;
+class StaticMesh;
+
+enum class RenderPass : std::uint8_t {
+    GEOMETRY,
+    SHADOW,
+    COUNT
+};
+
+// One mesh to draw with a shader and material at a model matrix.
+struct RenderItem {
+    RenderPass pass;
+    Shader* shader;
+    Material* material;
+    StaticMesh* mesh;
+    glm::mat4 model;
+};
+
+// Persistent list of draws, ordered by a 64-bit sort key so that items sharing GL state end up next to each other.
+// From the most significant bits down the key holds pass, shader, material, mesh and front-to-back depth, so
+// every run of equal state is contiguous and sorted near-to-far for early depth rejection.
+//
+// Nothing is freed between frames: clear() keeps every buffer's capacity, so once the scene has been seen at its
+// largest, submitting and sorting no longer touch the heap.
+class RenderQueue {
+public:
+    static constexpr int PASS_BITS = 4;
+    static constexpr int SHADER_BITS = 8;
+    static constexpr int MATERIAL_BITS = 16;
+    static constexpr int MESH_BITS = 16;
+    static constexpr int DEPTH_BITS = 20;
+    static_assert(PASS_BITS + SHADER_BITS + MATERIAL_BITS + MESH_BITS + DEPTH_BITS == 64, "sort key must fill 64 bits");
+
+    void clear();
+
+    // shader, material and mesh must not be null. depth is the view distance normalized to [0, 1]; values outside
+    // are clamped.
+    void submit(RenderPass pass, Shader* shader, Material* material, StaticMesh* mesh, const glm::mat4& model, float depth);
+
+    // Sorts the submitted items by key with an LSD radix sort.
+    void sort();
+
+    std::size_t size() const { return keys.size(); }
+    bool empty() const { return keys.empty(); }
+
+    // i-th item in sorted order (after sort()).
+    const RenderItem& getItem(std::size_t i) const { return items[keys[i].index]; }
+
+    // True if two items can share one draw call: same pass, shader, material and mesh.
+    static bool sameState(const RenderItem& a, const RenderItem& b) {
+        return a.pass == b.pass && a.shader == b.shader && a.material == b.material && a.mesh == b.mesh;
+    }
+
+private:
+    struct SortKey {
+        std::uint64_t key;
+        std::uint32_t index;
+    };
+
+    std::vector<RenderItem> items;
+    std::vector<SortKey> keys;
+    std::vector<SortKey> scratch;
+
+    // Keys hold the low bits of each resource's RenderResourceId. Ids wrap when a field overflows, which only
+    // costs some batching since sameState compares the real pointers.
+    static std::uint32_t maskId(std::uint32_t id, int bits) { return id & ((1u << bits) - 1); }
+};
@@ -0,0 +1,21 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Id a drawable resource takes when it is created, which RenderQueue packs into its sort keys. Every resource type
+// counts on its own, and ids are never handed out twice, so a resource created at a freed one's address starts
+// with a fresh id instead of inheriting the old one.
+template <typename Resource>
+class RenderResourceId {
+public:
+    RenderResourceId() : value(next.fetch_add(1, std::memory_order_relaxed)) {}
+    // A copy is a separate resource and gets its own id.
+    RenderResourceId(const RenderResourceId&) : RenderResourceId() {}
+    RenderResourceId& operator=(const RenderResourceId&) { return *this; }
+
+    std::uint32_t get() const { return value; }
+
+private:
+    std::uint32_t value;
+    static inline std::atomic<std::uint32_t> next{0};
+};
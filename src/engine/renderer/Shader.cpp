@@ -1,4 +1,7 @@
 #include "Shader.h"
+#include "FrameUniforms.h"
+#include "light/LightManager.h"
+#include <vector>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -77,50 +80,103 @@ bool Shader::loadFromFiles(const char* vertexPath, const char* fragmentPath) {
     glDeleteShader(vertex);
     glDeleteShader(fragment);
 
+    reflectUniforms();
+
+    // GLSL 3.30 has no layout(binding = N), so the shared uniform blocks are attached here
+    const struct { const char* name; GLuint binding; } sharedBlocks[] = {
+        {FrameUniforms::BLOCK_NAME, FrameUniforms::BINDING},
+        {LightManager::BLOCK_NAME, LightManager::BINDING},
+    };
+    for (const auto& block : sharedBlocks) {
+        GLuint blockIndex = glGetUniformBlockIndex(programID, block.name);
+        if (blockIndex != GL_INVALID_INDEX) {
+            glUniformBlockBinding(programID, blockIndex, block.binding);
+        }
+    }
+
     std::cout << "Shader loaded successfully" << std::endl;
     return true;
 }
 
+void Shader::reflectUniforms() {
+    uniformLocations.clear();
+
+    GLint uniformCount = 0;
+    GLint maxNameLength = 0;
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORMS, &uniformCount);
+    glGetProgramiv(programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+
+    std::vector<char> nameBuffer(static_cast<std::size_t>(maxNameLength) + 1);
+    for (GLint i = 0; i < uniformCount; ++i) {
+        GLsizei nameLength = 0;
+        GLint arraySize = 0;
+        GLenum type = 0;
+        glGetActiveUniform(programID, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()),
+                           &nameLength, &arraySize, &type, nameBuffer.data());
+        std::string name(nameBuffer.data(), nameLength);
+
+        // Uniform block members have no location; they are set through their buffer
+        GLint location = glGetUniformLocation(programID, name.c_str());
+        if (location == -1) continue;
+        uniformLocations[name] = location;
+
+        // Arrays of plain types are reported once as "name[0]"; register "name" and every element too
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+            std::string baseName = name.substr(0, name.size() - 3);
+            uniformLocations[baseName] = location;
+            for (GLint element = 1; element < arraySize; ++element) {
+                std::string elementName = baseName + "[" + std::to_string(element) + "]";
+                uniformLocations[elementName] = glGetUniformLocation(programID, elementName.c_str());
+            }
+        }
+    }
+}
+
+GLint Shader::getUniformLocation(const char* name) const {
+    auto it = uniformLocations.find(std::string_view(name));
+    return it != uniformLocations.end() ? it->second : -1;
+}
+
 void Shader::use() const {
     glUseProgram(programID);
 }
 
 void Shader::setMat4(const char* name, const glm::mat4& mat) const {
-    GLint location = glGetUniformLocation(programID, name);
+    GLint location = getUniformLocation(name);
     glUniformMatrix4fv(location, 1, GL_FALSE, &mat[0][0]);
 }
 
 void Shader::setVec3(const char* name, const glm::vec3& vec) const {
-    GLint location = glGetUniformLocation(programID, name);
+    GLint location = getUniformLocation(name);
     glUniform3fv(location, 1, &vec[0]);
 }
 
 void Shader::setVec2(const char* name, const glm::vec2& vec) const {
-    GLint location = glGetUniformLocation(programID, name);
+    GLint location = getUniformLocation(name);
     if (location != -1) {
         glUniform2f(location, vec.x, vec.y);
     }
 }
 
 void Shader::setVec4(const char* name, const glm::vec4& vec) const {
-    GLint location = glGetUniformLocation(programID, name);
+    GLint location = getUniformLocation(name);
     if (location != -1) {
         glUniform4f(location, vec.x, vec.y, vec.z, vec.w);
     }
 }
 
 void Shader::setFloat(const char* name, float value) const {
-    GLint location = glGetUniformLocation(programID, name);
+    GLint location = getUniformLocation(name);
     glUniform1f(location, value);
 }
 
 void Shader::setInt(const char* name, int value) const {
-    GLint location = glGetUniformLocation(programID, name);
+    GLint location = getUniformLocation(name);
     glUniform1i(location, value);
 }
 
 void Shader::setBool(const char* name, bool value) const {
-    GLint location = glGetUniformLocation(programID, name);
+    GLint location = getUniformLocation(name);
     glUniform1i(location, value);
 }
 
@@ -1,7 +1,12 @@
 #pragma once
 #include <glad/glad.h>
 #include <glm/glm.hpp>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "RenderResourceId.h"
 
 class Shader {
 public:
@@ -22,7 +27,23 @@ public:
     void setInt(const char* name, int value) const;
     void setBool(const char* name, bool value) const;
 
+    // Location of an active uniform, or -1 (which the setters ignore) if the program has none by that name.
+    // Looked up in a table filled once at link time instead of asking the driver on every call.
+    GLint getUniformLocation(const char* name) const;
+
+    std::uint32_t getRenderId() const { return renderId.get(); }
+
 private:
+    RenderResourceId<Shader> renderId;
+
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const { return std::hash<std::string_view>{}(name); }
+    };
+    std::unordered_map<std::string, GLint, NameHash, std::equal_to<>> uniformLocations;
+
+    void reflectUniforms();
+
     static bool compileShader(const char* source, GLenum type, GLuint& shader);
     static std::string readFile(const char* filePath);
 };
\ No newline at end of file
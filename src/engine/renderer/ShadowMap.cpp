@@ -6,7 +6,10 @@
 #include "../ecs/components/Transform.h"
 #include "../core/model/StaticMesh.h"
 #include "../ecs/components/StaticMeshComponent.h"
+#include "../debug/Profiler.h"
+#include "../ecs/components/Velocity.h"
 #include "../ecs/Entity.h"
+#include "Frustum.h"
 
 ShadowMap::ShadowMap() : depthMapFBO(0), shadowTexture(0) {
 }
@@ -49,11 +52,12 @@ bool ShadowMap::initialize(LightManager& lightManager) {
 }
 
 // Synchronizes with light manager (ex. moving Directional Light)
-void ShadowMap::updateLightSpaceTransform(LightManager& lightManager) {
+void ShadowMap::updateLightSpaceTransform(const LightManager& lightManager) {
     // Directional light position is the opposite it's direction * scalar
     glm::vec3 directionalLightPosition;
+    // Read through the const view; getDirectionalLight() would re-upload the light every frame
     if (lightManager.getDirectionalLightCount() >= 1) {
-        directionalLightPosition = glm::normalize(lightManager.getDirectionalLight(0).direction) * -directionLightPositionScalar;
+        directionalLightPosition = glm::normalize(lightManager.getDirectionalLights()[0].direction) * -directionLightPositionScalar;
     } else {
         directionalLightPosition = glm::normalize(glm::vec3(-1.0f, 2.0f, -1.0f)) * -directionLightPositionScalar;
     }
@@ -66,11 +70,9 @@ void ShadowMap::updateLightSpaceTransform(LightManager& lightManager) {
 }
 
 void ShadowMap::render(World& world) {
-    GLint lightSpaceMatrixLocation = glGetUniformLocation(simpleDepthShader.programID, "lightSpaceMatrix");
-
+    DUCK_PROFILE_SCOPE("ShadowMap::render");
+    // lightSpaceMatrix comes from the FrameData uniform block
     simpleDepthShader.use();
-    glUniformMatrix4fv(lightSpaceMatrixLocation, 1, GL_FALSE, glm::value_ptr(lightSpaceMatrix));
-    simpleDepthShader.setMat4("lightSpaceMatrix", lightSpaceMatrix);
 
     glViewport(0, 0, resolutionWidth, resolutionHeight);
     glBindFramebuffer(GL_FRAMEBUFFER, depthMapFBO);
@@ -82,20 +84,40 @@ void ShadowMap::render(World& world) {
 }
 
 void ShadowMap::renderScene(World& world) {
-    for (auto& entity : world.EntityManager.GetEntities())
-    {
-        if (entity->hasComponent<StaticMeshComponent>())
-        {
-            auto& staticMeshComponent = entity->getComponent<StaticMeshComponent>();
-
-            auto& transform = entity->getComponent<Transform>();
-            glm::mat4 model = TransformSystem::getTransformMatrix(transform);
-
-            simpleDepthShader.setMat4("model", model);
-
-            staticMeshComponent.Mesh->bind();
-            staticMeshComponent.Mesh->draw();
-        }
+    casters.clear();
+    casterBounds.clear();
+    world.EntityManager.ForEachChunk<Transform, StaticMeshComponent>(
+        [&](std::size_t count, Entity** entities, Transform* transforms, StaticMeshComponent* meshComponents) {
+            // One archetype per chunk, so one Velocity check decides interpolation for all of it.
+            bool bInterpolate = entities[0]->hasComponent<Velocity>();
+
+            for (std::size_t i = 0; i < count; ++i) {
+                // Destroyed entities can linger until the next cleanup pass.
+                if (!entities[i]->getIsActive()) continue;
+                if (!meshComponents[i].Mesh) continue;
+
+                glm::mat4 model = bInterpolate
+                    ? TransformSystem::getInterpolatedTransformMatrix(transforms[i], world.interpolationAlpha)
+                    : TransformSystem::getTransformMatrix(transforms[i]);
+
+                StaticMesh* mesh = meshComponents[i].Mesh.get();
+                glm::vec3 worldMin, worldMax;
+                transformAABB(model, mesh->getMinBounds(), mesh->getMaxBounds(), worldMin, worldMax);
+                casterBounds.add(worldMin, worldMax);
+                casters.push_back({mesh, model});
+            }
+        });
+
+    // Anything outside the light's ortho volume is clipped away anyway
+    casterVisible.resize(casters.size());
+    cullAABBBatch(Frustum::fromViewProjection(lightSpaceMatrix), casterBounds, casterVisible.data());
+
+    for (std::size_t i = 0; i < casters.size(); ++i) {
+        if (!casterVisible[i]) continue;
+
+        simpleDepthShader.setMat4("model", casters[i].model);
+        casters[i].mesh->bind();
+        casters[i].mesh->draw();
     }
 }
 
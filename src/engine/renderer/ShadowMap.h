@@ -8,8 +8,12 @@
 #include "../ecs/World.h"
 
 #include "Shader.h"
+#include "../physics/RaycastUtils.h"
+#include <cstdint>
+#include <vector>
 
 class Entity;
+class StaticMesh;
 
 class ShadowMap {
 public:
@@ -31,7 +35,7 @@ public:
         return lightSpaceMatrix;
     }
 
-    void updateLightSpaceTransform(LightManager& lightManager);
+    void updateLightSpaceTransform(const LightManager& lightManager);
 
 private:
     /*
@@ -58,4 +62,13 @@ private:
     glm::mat4 lightProjection;
     glm::mat4 lightView;
     glm::mat4 lightSpaceMatrix;
+
+    // Casters gathered for culling against the light volume; kept between frames to reuse their capacity
+    struct ShadowCaster {
+        StaticMesh* mesh;
+        glm::mat4 model;
+    };
+    std::vector<ShadowCaster> casters;
+    Physics::AABBBatch casterBounds;
+    std::vector<std::uint8_t> casterVisible;
 };
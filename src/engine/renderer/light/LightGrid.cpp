@@ -0,0 +1,165 @@
+#include "LightGrid.h"
+#include "LightManager.h"
+#include "../Camera.h"
+#include "../Shader.h"
+#include <algorithm>
+#include <cmath>
+
+bool LightGrid::initialize() {
+    glGenBuffers(1, &gridBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, gridBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, CLUSTER_COUNT * 2 * sizeof(std::uint32_t), nullptr, GL_STREAM_DRAW);
+    glGenTextures(1, &gridTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, gridTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, gridBuffer);
+
+    glGenBuffers(1, &indexBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, indexBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, sizeof(std::uint16_t), nullptr, GL_STREAM_DRAW);
+    glGenTextures(1, &indexTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, indexTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R16UI, indexBuffer);
+
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    clusterData.assign(CLUSTER_COUNT * 2, 0);
+    return gridTexture != 0 && indexTexture != 0;
+}
+
+void LightGrid::cleanup() {
+    if (gridTexture) glDeleteTextures(1, &gridTexture);
+    if (indexTexture) glDeleteTextures(1, &indexTexture);
+    if (gridBuffer) glDeleteBuffers(1, &gridBuffer);
+    if (indexBuffer) glDeleteBuffers(1, &indexBuffer);
+    gridTexture = indexTexture = gridBuffer = indexBuffer = 0;
+}
+
+int LightGrid::getSlice(float viewDepth) const {
+    int slice = static_cast<int>(std::floor(std::log(viewDepth) * sliceScale - sliceBias));
+    return std::clamp(slice, 0, SLICES - 1);
+}
+
+float LightGrid::getSliceNear(int slice, float nearPlane, float farPlane) const {
+    return nearPlane * std::pow(farPlane / nearPlane, static_cast<float>(slice) / SLICES);
+}
+
+void LightGrid::build(const LightManager& lightManager, const Camera& camera, int screenWidth, int screenHeight) {
+    float nearPlane = camera.nearPlane;
+    float farPlane = camera.farPlane;
+
+    // slice = log(depth) * scale - bias puts near at slice 0 and far at SLICES
+    sliceScale = SLICES / std::log(farPlane / nearPlane);
+    sliceBias = SLICES * std::log(nearPlane) / std::log(farPlane / nearPlane);
+    tileSize = glm::vec2(static_cast<float>(screenWidth) / TILES_X, static_cast<float>(screenHeight) / TILES_Y);
+
+    glm::mat4 view = camera.getViewMatrix();
+    glm::mat4 projection = camera.getProjectionMatrix();
+    const std::vector<PointLight>& pointLights = lightManager.getPointLights();
+
+    spans.clear();
+    for (std::size_t i = 0; i < pointLights.size(); ++i) {
+        const PointLight& light = pointLights[i];
+        if (!light.enabled) continue;
+
+        glm::vec3 center = glm::vec3(view * glm::vec4(light.position, 1.0f));
+        float radius = light.attenuationRadius;
+        // Distances in front of the camera; view space looks down -z
+        float lightNear = -center.z - radius;
+        float lightFar = -center.z + radius;
+        if (lightFar < nearPlane || lightNear > farPlane) continue;
+
+        int firstSlice = getSlice(std::max(lightNear, nearPlane));
+        int lastSlice = getSlice(std::min(lightFar, farPlane));
+
+        for (int slice = firstSlice; slice <= lastSlice; ++slice) {
+            // The light's box, cut to this slice, is in front of the camera, so its projected corners bound it on screen
+            float sliceNear = std::max(lightNear, getSliceNear(slice, nearPlane, farPlane));
+            float sliceFar = std::min(lightFar, getSliceNear(slice + 1, nearPlane, farPlane));
+            if (sliceNear > sliceFar) continue;
+
+            glm::vec2 ndcMin(1.0f), ndcMax(-1.0f);
+            for (int corner = 0; corner < 8; ++corner) {
+                glm::vec4 point((corner & 1) ? center.x + radius : center.x - radius,
+                                (corner & 2) ? center.y + radius : center.y - radius,
+                                (corner & 4) ? -sliceFar : -sliceNear,
+                                1.0f);
+                glm::vec4 clip = projection * point;
+                glm::vec2 ndc = glm::vec2(clip) / clip.w;
+                ndcMin = glm::min(ndcMin, ndc);
+                ndcMax = glm::max(ndcMax, ndc);
+            }
+            if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f) continue;
+
+            auto toTile = [](float ndc, int tiles) {
+                return static_cast<std::uint16_t>(std::clamp(static_cast<int>((ndc * 0.5f + 0.5f) * tiles), 0, tiles - 1));
+            };
+            spans.push_back({static_cast<std::uint16_t>(i), static_cast<std::uint16_t>(slice),
+                             toTile(ndcMin.x, TILES_X), toTile(ndcMax.x, TILES_X),
+                             toTile(ndcMin.y, TILES_Y), toTile(ndcMax.y, TILES_Y)});
+        }
+    }
+
+    auto forEachCluster = [](const LightSpan& span, auto&& visit) {
+        for (int y = span.minY; y <= span.maxY; ++y) {
+            for (int x = span.minX; x <= span.maxX; ++x) {
+                visit(x + TILES_X * (y + TILES_Y * span.slice));
+            }
+        }
+    };
+
+    // Count lights per cluster, turn the counts into offsets, then fill the index list in a second pass
+    std::fill(clusterData.begin(), clusterData.end(), 0);
+    for (const LightSpan& span : spans) {
+        forEachCluster(span, [&](int cluster) { ++clusterData[cluster * 2 + 1]; });
+    }
+
+    std::uint32_t offset = 0;
+    for (int cluster = 0; cluster < CLUSTER_COUNT; ++cluster) {
+        clusterData[cluster * 2] = offset;
+        offset += clusterData[cluster * 2 + 1];
+        clusterData[cluster * 2 + 1] = 0;
+    }
+
+    lightIndices.resize(std::max<std::uint32_t>(offset, 1));
+    for (const LightSpan& span : spans) {
+        forEachCluster(span, [&](int cluster) {
+            std::uint32_t& count = clusterData[cluster * 2 + 1];
+            lightIndices[clusterData[cluster * 2] + count++] = span.light;
+        });
+    }
+
+    glBindBuffer(GL_TEXTURE_BUFFER, gridBuffer);
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, clusterData.size() * sizeof(std::uint32_t), clusterData.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, indexBuffer);
+    // Respecified every frame: the list changes size, and fresh storage avoids waiting on the previous frame
+    glBufferData(GL_TEXTURE_BUFFER, lightIndices.size() * sizeof(std::uint16_t), lightIndices.data(), GL_STREAM_DRAW);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void LightGrid::bind(Shader& shader, unsigned int gridUnit, unsigned int indexUnit) const {
+    glActiveTexture(GL_TEXTURE0 + gridUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, gridTexture);
+    shader.setInt("clusterGrid", static_cast<int>(gridUnit));
+
+    glActiveTexture(GL_TEXTURE0 + indexUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, indexTexture);
+    shader.setInt("clusterLights", static_cast<int>(indexUnit));
+
+    shader.setVec2("clusterTileSize", tileSize);
+    shader.setFloat("clusterSliceScale", sliceScale);
+    shader.setFloat("clusterSliceBias", sliceBias);
+}
+
+float LightGrid::getAverageLightsPerCluster() const {
+    int occupied = 0;
+    std::uint32_t total = 0;
+    for (int cluster = 0; cluster < CLUSTER_COUNT; ++cluster) {
+        std::uint32_t count = clusterData[cluster * 2 + 1];
+        if (count > 0) {
+            ++occupied;
+            total += count;
+        }
+    }
+    return occupied > 0 ? static_cast<float>(total) / occupied : 0.0f;
+}
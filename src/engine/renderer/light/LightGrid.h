@@ -0,0 +1,59 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+class Camera;
+class LightManager;
+class Shader;
+
+// Clustered light culling for the lighting pass. The view frustum is split into TILES_X * TILES_Y screen tiles
+// and SLICES depth slices (exponentially spaced, so clusters stay roughly cube-shaped). Every frame the CPU lists,
+// for each cluster, the point lights whose radius reaches into it; light.frag then shades only its pixel's cluster
+// instead of looping over every light.
+//
+// The lists go to the GPU as two texture buffers: one (offset, count) pair per cluster, and the light indices
+// they point into. TILES_X, TILES_Y and SLICES must match light.frag.
+class LightGrid {
+public:
+    static constexpr int TILES_X = 16;
+    static constexpr int TILES_Y = 9;
+    static constexpr int SLICES = 24;
+    static constexpr int CLUSTER_COUNT = TILES_X * TILES_Y * SLICES;
+
+    bool initialize();
+    void cleanup();
+
+    // Assigns the enabled point lights to clusters and uploads the result.
+    void build(const LightManager& lightManager, const Camera& camera, int screenWidth, int screenHeight);
+
+    // Binds the grid to two texture units and sets the cluster uniforms of the lighting shader.
+    void bind(Shader& shader, unsigned int gridUnit, unsigned int indexUnit) const;
+
+    // Average lights per non-empty cluster in the last build, to compare against the light count.
+    float getAverageLightsPerCluster() const;
+
+private:
+    // Clusters a light covers in one slice: an inclusive rectangle of tiles
+    struct LightSpan {
+        std::uint16_t light;
+        std::uint16_t slice;
+        std::uint16_t minX, maxX, minY, maxY;
+    };
+
+    // All kept between frames so that building the grid does not allocate once they have grown
+    std::vector<LightSpan> spans;
+    std::vector<std::uint32_t> clusterData;   // offset, count per cluster
+    std::vector<std::uint16_t> lightIndices;
+
+    float sliceScale = 0.0f;
+    float sliceBias = 0.0f;
+    glm::vec2 tileSize = glm::vec2(1.0f);
+
+    GLuint gridBuffer = 0, gridTexture = 0;
+    GLuint indexBuffer = 0, indexTexture = 0;
+
+    int getSlice(float viewDepth) const;
+    float getSliceNear(int slice, float nearPlane, float farPlane) const;
+};
@@ -1,26 +1,32 @@
 #include <iostream>
+#include <algorithm>
 #include "LightManager.h"
-#include "../src/engine/renderer/Shader.h"
 
 void LightManager::addDirectionalLight(const DirectionalLight &directionalLight) {
-    if (directionalLights.size() > MAX_DIR_LIGHTS) {
+    if (directionalLights.size() >= MAX_DIR_LIGHTS) {
         std::cerr << "Warning broski: Max directional light reached (" << MAX_DIR_LIGHTS << ")" << std::endl;
         return;
     }
     directionalLights.push_back(directionalLight);
+    bCountsDirty = true;
+    bDirectionalDirty = true;
 }
 
 void LightManager::addPointLight(const PointLight &pointLight) {
-    if (pointLights.size() > MAX_POINT_LIGHTS) {
+    if (pointLights.size() >= MAX_POINT_LIGHTS) {
         std::cerr << "Warning broski: Max point light reached (" << MAX_POINT_LIGHTS << ")" << std::endl;
         return;
     }
     pointLights.push_back(pointLight);
+    bCountsDirty = true;
+    markPointLightsDirty(pointLights.size() - 1, pointLights.size());
 }
 
 bool LightManager::removeDirectionalLight(size_t index) {
     if (index < directionalLights.size()) {
         directionalLights.erase(directionalLights.begin() + index);
+        bCountsDirty = true;
+        bDirectionalDirty = true;
         return true;
     }
     return false;
@@ -29,6 +35,9 @@ bool LightManager::removeDirectionalLight(size_t index) {
 bool LightManager::removePointLight(size_t index) {
     if (index < pointLights.size()) {
         pointLights.erase(pointLights.begin() + index);
+        bCountsDirty = true;
+        // Every light after the removed one moved down a slot
+        markPointLightsDirty(index, pointLights.size());
         return true;
     }
     return false;
@@ -37,49 +46,98 @@ bool LightManager::removePointLight(size_t index) {
 void LightManager::removeAllLights() {
     directionalLights.clear();
     pointLights.clear();
+    bCountsDirty = true;
 }
 
 void LightManager::removeAllPointLights() {
     pointLights.clear();
+    bCountsDirty = true;
 }
 
 void LightManager::removeAllDirectionLight() {
     directionalLights.clear();
+    bCountsDirty = true;
 }
 
 DirectionalLight & LightManager::getDirectionalLight(size_t index) {
-    return directionalLights.at(index);
+    DirectionalLight& light = directionalLights.at(index);
+    bDirectionalDirty = true;
+    return light;
 }
 
 PointLight & LightManager::getPointLight(size_t index) {
-    return pointLights.at(index);
+    PointLight& light = pointLights.at(index);
+    markPointLightsDirty(index, index + 1);
+    return light;
 }
 
-void LightManager::uploadToShader(Shader &shader) const {
-    int numDirLights = static_cast<int>(directionalLights.size());
-    shader.setInt("numDirLights", numDirLights);
-
-    for (int i = 0; i < numDirLights; ++i) {
-        std::string prefix = "dirLights[" + std::to_string(i) + "].";
-        const auto& light = directionalLights[i];
+void LightManager::markPointLightsDirty(size_t begin, size_t end) {
+    if (begin >= end) return;
+    if (dirtyPointBegin >= dirtyPointEnd) {
+        dirtyPointBegin = begin;
+        dirtyPointEnd = end;
+    } else {
+        dirtyPointBegin = std::min(dirtyPointBegin, begin);
+        dirtyPointEnd = std::max(dirtyPointEnd, end);
+    }
+}
 
-        shader.setVec3((prefix + "direction").c_str(), light.direction);
-        shader.setVec3((prefix + "color").c_str(), light.color * light.intensity);
-        shader.setBool((prefix + "enabled").c_str(), light.enabled);
+#ifndef DUCK_HEADLESS
+void LightManager::upload() {
+    if (lightBuffer == 0) {
+        glGenBuffers(1, &lightBuffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, lightBuffer);
+        glBufferData(GL_UNIFORM_BUFFER, BLOCK_SIZE, nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, BINDING, lightBuffer);
+
+        bCountsDirty = true;
+        bDirectionalDirty = true;
+        markPointLightsDirty(0, pointLights.size());
     }
 
-    int numPointLights = static_cast<int>(pointLights.size());
-    shader.setInt("numPointLights", numPointLights);
+    bool bPointLightsDirty = dirtyPointBegin < std::min(dirtyPointEnd, pointLights.size());
+    if (!bCountsDirty && !bDirectionalDirty && !bPointLightsDirty) return;
 
-    for (int i = 0; i < numPointLights; ++i) {
-        std::string prefix = "pointLights[" + std::to_string(i) + "].";
-        const auto& light = pointLights[i];
+    glBindBuffer(GL_UNIFORM_BUFFER, lightBuffer);
 
-        shader.setVec3((prefix + "position").c_str(), light.position);
-        shader.setVec3((prefix + "color").c_str(), light.color * light.intensity);
-        shader.setFloat((prefix + "radius").c_str(), light.attenuationRadius);
-        shader.setBool((prefix + "enabled").c_str(), light.enabled);
+    if (bCountsDirty) {
+        std::int32_t counts[2] = {static_cast<std::int32_t>(directionalLights.size()),
+                                  static_cast<std::int32_t>(pointLights.size())};
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(counts), counts);
     }
-}
 
+    if (bDirectionalDirty && !directionalLights.empty()) {
+        GpuDirectionalLight packed[MAX_DIR_LIGHTS] = {};
+        for (size_t i = 0; i < directionalLights.size(); ++i) {
+            const auto& light = directionalLights[i];
+            packed[i] = {light.direction, light.enabled ? 1u : 0u, light.color * light.intensity, 0.0f};
+        }
+        glBufferSubData(GL_UNIFORM_BUFFER, DIR_LIGHTS_OFFSET, directionalLights.size() * sizeof(GpuDirectionalLight), packed);
+    }
 
+    // Only the range that changed; lights past the count are never read, so removed ones need no upload
+    if (bPointLightsDirty) {
+        size_t end = std::min(dirtyPointEnd, pointLights.size());
+        packedPointLights.clear();
+        for (size_t i = dirtyPointBegin; i < end; ++i) {
+            const auto& light = pointLights[i];
+            packedPointLights.push_back({light.position, light.attenuationRadius,
+                                         light.color * light.intensity, light.enabled ? 1u : 0u});
+        }
+        glBufferSubData(GL_UNIFORM_BUFFER, POINT_LIGHTS_OFFSET + dirtyPointBegin * sizeof(GpuPointLight),
+                        packedPointLights.size() * sizeof(GpuPointLight), packedPointLights.data());
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    bCountsDirty = false;
+    bDirectionalDirty = false;
+    dirtyPointBegin = 0;
+    dirtyPointEnd = 0;
+}
+
+void LightManager::cleanup() {
+    if (lightBuffer) glDeleteBuffers(1, &lightBuffer);
+    lightBuffer = 0;
+}
+#endif
@@ -1,12 +1,20 @@
 #pragma once
 #include "Light.h"
 #include "../src/engine/renderer/Shader.h"
+#include <cstdint>
+#include <vector>
 
-constexpr int MAX_POINT_LIGHTS = 16;
+// Make sure to match these in light.frag
+constexpr int MAX_POINT_LIGHTS = 256;
 constexpr int MAX_DIR_LIGHTS = 1;
 
 class LightManager {
 public:
+    // Lights live in the std140 LightData uniform block at this binding; Shader::loadFromFiles attaches programs
+    // that declare it.
+    static constexpr GLuint BINDING = 1;
+    static constexpr const char* BLOCK_NAME = "LightData";
+
     void addDirectionalLight(const DirectionalLight& directionalLight);
     void addPointLight(const PointLight& pointLight);
 
@@ -17,17 +25,55 @@ public:
     void removeAllPointLights();
     void removeAllDirectionLight();
 
+    // The returned light is re-uploaded on the next upload(), so change lights through these every time
+    // instead of keeping the reference around.
     DirectionalLight& getDirectionalLight(size_t index);
     PointLight& getPointLight(size_t index);
 
     [[nodiscard]] size_t getPointLightCount() const {return pointLights.size();}
     [[nodiscard]] size_t getDirectionalLightCount() const {return directionalLights.size();}
+    // Read-only views, in the same order as the arrays of the light buffer; reading doesn't mark anything dirty
+    [[nodiscard]] const std::vector<DirectionalLight>& getDirectionalLights() const {return directionalLights;}
+    [[nodiscard]] const std::vector<PointLight>& getPointLights() const {return pointLights;}
 
-    void uploadToShader(Shader& shader) const;
+    // Headless builds have no GL context; the lights are still kept so gameplay code can query them.
+#ifndef DUCK_HEADLESS
+    // Writes the lights that changed since the last call into the light buffer, creating it on first use.
+    void upload();
+    void cleanup();
+#endif
 private:
     std::vector<DirectionalLight> directionalLights;
     std::vector<PointLight> pointLights;
 
-};
+    // std140 layouts of the GLSL structs, intensity already folded into color
+    struct GpuDirectionalLight {
+        glm::vec3 direction;
+        std::uint32_t enabled;
+        glm::vec3 color;
+        float padding;
+    };
+    struct GpuPointLight {
+        glm::vec3 position;
+        float radius;
+        glm::vec3 color;
+        std::uint32_t enabled;
+    };
+    static_assert(sizeof(GpuDirectionalLight) == 32 && sizeof(GpuPointLight) == 32, "std140 light structs are 32 bytes");
 
+    // Byte offsets inside the block: the two counts, then the arrays, each aligned to 16
+    static constexpr std::size_t DIR_LIGHTS_OFFSET = 16;
+    static constexpr std::size_t POINT_LIGHTS_OFFSET = DIR_LIGHTS_OFFSET + MAX_DIR_LIGHTS * sizeof(GpuDirectionalLight);
+    static constexpr std::size_t BLOCK_SIZE = POINT_LIGHTS_OFFSET + MAX_POINT_LIGHTS * sizeof(GpuPointLight);
 
+    // What changed since the last upload; point lights as the index range [dirtyPointBegin, dirtyPointEnd)
+    bool bCountsDirty = true;
+    bool bDirectionalDirty = true;
+    size_t dirtyPointBegin = 0;
+    size_t dirtyPointEnd = 0;
+    void markPointLightsDirty(size_t begin, size_t end);
+
+    GLuint lightBuffer = 0;
+    // Staging for the dirty point lights, kept to avoid allocating on every upload
+    std::vector<GpuPointLight> packedPointLights;
+};
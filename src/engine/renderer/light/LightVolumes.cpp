@@ -0,0 +1,229 @@
+#include "LightVolumes.h"
+#include "LightManager.h"
+#include "../Camera.h"
+#include "../Frustum.h"
+#include "../GBuffer.h"
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+bool LightVolumes::initialize(const GBuffer& gBuffer) {
+    if (!stencilShader.loadFromFiles("../assets/shaders/light_volume.vert", "../assets/shaders/light_volume_stencil.frag")) {
+        std::cerr << "Failed to load light volume stencil shader" << std::endl;
+        return false;
+    }
+    if (!volumeShader.loadFromFiles("../assets/shaders/light_volume.vert", "../assets/shaders/light_volume.frag")) {
+        std::cerr << "Failed to load light volume shader" << std::endl;
+        return false;
+    }
+    if (!resolveShader.loadFromFiles("../assets/shaders/light_resolve.vert", "../assets/shaders/light_resolve.frag")) {
+        std::cerr << "Failed to load light resolve shader" << std::endl;
+        return false;
+    }
+
+    // G-buffer units as bound by the lighting pass; fixed, so set once
+    volumeShader.use();
+    volumeShader.setInt("gPosition", 0);
+    volumeShader.setInt("gNormal", 1);
+    volumeShader.setInt("gAlbedo", 2);
+    volumeShader.setInt("gMetallicRoughness", 3);
+    volumeShader.setInt("gDepth", 0);
+    volumeShader.setBool("compactGBuffer", gBuffer.isCompact());
+    resolveShader.use();
+    resolveShader.setInt("accumulation", 0);
+
+    createSphere();
+    glGenVertexArrays(1, &emptyVAO);
+
+    width = gBuffer.getWidth();
+    height = gBuffer.getHeight();
+    return createTarget();
+}
+
+void LightVolumes::resize(const GBuffer& gBuffer) {
+    width = gBuffer.getWidth();
+    height = gBuffer.getHeight();
+    deleteTarget();
+    createTarget();
+}
+
+void LightVolumes::cleanup() {
+    deleteTarget();
+    if (sphereVAO) glDeleteVertexArrays(1, &sphereVAO);
+    if (sphereVBO) glDeleteBuffers(1, &sphereVBO);
+    if (sphereEBO) glDeleteBuffers(1, &sphereEBO);
+    if (emptyVAO) glDeleteVertexArrays(1, &emptyVAO);
+    sphereVAO = sphereVBO = sphereEBO = emptyVAO = 0;
+}
+
+void LightVolumes::createSphere() {
+    constexpr int RINGS = 12;
+    constexpr int SEGMENTS = 16;
+
+    std::vector<glm::vec3> vertices;
+    for (int ring = 0; ring <= RINGS; ++ring) {
+        float theta = glm::pi<float>() * ring / RINGS;
+        for (int segment = 0; segment <= SEGMENTS; ++segment) {
+            float phi = glm::two_pi<float>() * segment / SEGMENTS;
+            vertices.emplace_back(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+        }
+    }
+
+    std::vector<std::uint16_t> indices;
+    float innerRadius = 1.0f;
+    auto addTriangle = [&](int a, int b, int c) {
+        glm::vec3 normal = glm::cross(vertices[b] - vertices[a], vertices[c] - vertices[a]);
+        if (glm::length(normal) < 1e-6f) return; // Collapsed at the poles
+        // Wind every triangle counter-clockwise seen from outside, so culling can pick front or back faces
+        if (glm::dot(normal, vertices[a]) < 0.0f) {
+            std::swap(b, c);
+            normal = -normal;
+        }
+        innerRadius = std::min(innerRadius, glm::dot(glm::normalize(normal), vertices[a]));
+        indices.insert(indices.end(), {static_cast<std::uint16_t>(a), static_cast<std::uint16_t>(b),
+                                       static_cast<std::uint16_t>(c)});
+    };
+    for (int ring = 0; ring < RINGS; ++ring) {
+        for (int segment = 0; segment < SEGMENTS; ++segment) {
+            int current = ring * (SEGMENTS + 1) + segment;
+            int below = current + SEGMENTS + 1;
+            addTriangle(current, below, current + 1);
+            addTriangle(current + 1, below, below + 1);
+        }
+    }
+
+    // The faces cut inside the unit sphere; scale the mesh up so it fully contains the light's radius
+    for (glm::vec3& vertex : vertices) {
+        vertex /= innerRadius;
+    }
+
+    glGenVertexArrays(1, &sphereVAO);
+    glGenBuffers(1, &sphereVBO);
+    glGenBuffers(1, &sphereEBO);
+    glBindVertexArray(sphereVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, sphereVBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(glm::vec3), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, sphereEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(std::uint16_t), indices.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), static_cast<void*>(nullptr));
+    glBindVertexArray(0);
+
+    sphereIndexCount = static_cast<GLsizei>(indices.size());
+}
+
+bool LightVolumes::createTarget() {
+    // Linear HDR light; tone mapping waits until every light has been added
+    glGenTextures(1, &accumulationTexture);
+    glBindTexture(GL_TEXTURE_2D, accumulationTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // The scene's depth for the stencil test, and the stencil bits that mark each light's pixels. Same format as
+    // the G-buffer's depth, which blitting between the two requires.
+    glGenRenderbuffers(1, &depthStencilBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthStencilBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, accumulationTexture, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthStencilBuffer);
+
+    bool bComplete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    if (!bComplete) {
+        std::cerr << "Light volume framebuffer is not complete!" << std::endl;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return bComplete;
+}
+
+void LightVolumes::deleteTarget() {
+    if (accumulationTexture) glDeleteTextures(1, &accumulationTexture);
+    if (depthStencilBuffer) glDeleteRenderbuffers(1, &depthStencilBuffer);
+    if (fbo) glDeleteFramebuffers(1, &fbo);
+    accumulationTexture = depthStencilBuffer = fbo = 0;
+}
+
+void LightVolumes::beginAccumulation(const GBuffer& gBuffer) {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, gBuffer.getFramebuffer());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo);
+    glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, width, height);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glStencilMask(0xFF);
+    glClearStencil(0);
+    glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+}
+
+void LightVolumes::renderPointLights(const LightManager& lightManager, const Camera& camera) {
+    Frustum frustum = Frustum::fromViewProjection(camera.getProjectionMatrix() * camera.getViewMatrix());
+    const std::vector<PointLight>& pointLights = lightManager.getPointLights();
+
+    glBindVertexArray(sphereVAO);
+    glEnable(GL_STENCIL_TEST);
+    glDepthMask(GL_FALSE);
+    glBlendFunc(GL_ONE, GL_ONE);
+
+    for (std::size_t i = 0; i < pointLights.size(); ++i) {
+        const PointLight& light = pointLights[i];
+        if (!light.enabled) continue;
+        glm::vec3 extent(light.attenuationRadius);
+        if (!frustum.intersectsAABB(light.position - extent, light.position + extent)) continue;
+
+        // Stencil: along each pixel's ray, back faces behind the scene count up and front faces behind it count
+        // down, so only geometry inside the sphere is left non-zero. Also works with the camera inside the sphere,
+        // where the clipped front faces never count down.
+        stencilShader.use();
+        stencilShader.setInt("lightIndex", static_cast<int>(i));
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glEnable(GL_DEPTH_TEST);
+        glDisable(GL_CULL_FACE);
+        glDisable(GL_BLEND);
+        glStencilFunc(GL_ALWAYS, 0, 0xFF);
+        glStencilOpSeparate(GL_BACK, GL_KEEP, GL_INCR_WRAP, GL_KEEP);
+        glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_DECR_WRAP, GL_KEEP);
+        glDrawElements(GL_TRIANGLES, sphereIndexCount, GL_UNSIGNED_SHORT, nullptr);
+
+        // Light: back faces cover the sphere's whole silhouette even from inside it. Shading a pixel also
+        // zeroes its stencil, leaving the buffer clear for the next light.
+        volumeShader.use();
+        volumeShader.setInt("lightIndex", static_cast<int>(i));
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDisable(GL_DEPTH_TEST);
+        glEnable(GL_CULL_FACE);
+        glCullFace(GL_FRONT);
+        glEnable(GL_BLEND);
+        glStencilFunc(GL_NOTEQUAL, 0, 0xFF);
+        glStencilOp(GL_KEEP, GL_ZERO, GL_ZERO);
+        glDrawElements(GL_TRIANGLES, sphereIndexCount, GL_UNSIGNED_SHORT, nullptr);
+    }
+
+    glCullFace(GL_BACK);
+    glDisable(GL_CULL_FACE);
+    glDisable(GL_BLEND);
+    glDisable(GL_STENCIL_TEST);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_DEPTH_TEST);
+    glBindVertexArray(0);
+}
+
+void LightVolumes::resolve() {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    resolveShader.use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, accumulationTexture);
+    glBindVertexArray(emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+}
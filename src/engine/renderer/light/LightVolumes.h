@@ -0,0 +1,52 @@
+#pragma once
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include "../Shader.h"
+
+class Camera;
+class GBuffer;
+class LightManager;
+
+// Alternative lighting path: instead of every pixel looping over its point lights in light.frag, each point light
+// is drawn as a sphere around its radius, so a light only costs the pixels it actually covers.
+//
+// The fullscreen lighting pass (ambient, IBL and directional lights) writes linear HDR color into an accumulation
+// target with a depth-stencil renderbuffer of its own, which gets a copy of the G-buffer's depth every frame. The
+// lighting shaders sample the G-buffer's depth texture, so it can never be attached here as well. Each light then
+// runs a stencil pass that marks the pixels whose geometry lies inside the sphere, and a lighting pass that adds the
+// light to just those pixels. resolve() tone maps the result to the default framebuffer.
+class LightVolumes {
+public:
+    bool initialize(const GBuffer& gBuffer);
+    // Call after the G-buffer has been resized, so the targets keep its size
+    void resize(const GBuffer& gBuffer);
+    void cleanup();
+
+    // Copies the G-buffer's depth, then binds the accumulation target and clears its color and stencil, ready for
+    // the fullscreen ambient pass
+    void beginAccumulation(const GBuffer& gBuffer);
+
+    // Adds every enabled point light in view. Expects the G-buffer textures on units 0-3, as bound for light.frag.
+    void renderPointLights(const LightManager& lightManager, const Camera& camera);
+
+    // Tone maps the accumulated light into the default framebuffer
+    void resolve();
+
+private:
+    Shader stencilShader;
+    Shader volumeShader;
+    Shader resolveShader;
+
+    GLuint sphereVAO = 0, sphereVBO = 0, sphereEBO = 0;
+    GLsizei sphereIndexCount = 0;
+    GLuint emptyVAO = 0; // The resolve pass builds its fullscreen triangle from gl_VertexID
+
+    GLuint fbo = 0;
+    GLuint accumulationTexture = 0;
+    GLuint depthStencilBuffer = 0;
+    int width = 0, height = 0;
+
+    void createSphere();
+    bool createTarget();
+    void deleteTarget();
+};
@@ -0,0 +1,31 @@
+#include "engine/core/HeadlessEngine.h"
+#include "engine/debug/Profiler.h"
+#include <cstdlib>
+#include <iostream>
+
+// Usage: DuckEngineHeadless [frames] [frameTimeSeconds]
+int main(int argc, char** argv) {
+    int frameCount = argc > 1 ? std::atoi(argv[1]) : 3600;
+    float frameTime = argc > 2 ? static_cast<float>(std::atof(argv[2])) : FixedStepClock::FIXED_TIMESTEP;
+
+    if (frameCount <= 0 || frameTime <= 0.0f) {
+        std::cerr << "Usage: " << argv[0] << " [frames] [frameTimeSeconds]" << std::endl;
+        return -1;
+    }
+
+    HeadlessEngine engine;
+    if (!engine.initialize()) {
+        std::cerr << "Failed to initialize headless engine" << std::endl;
+        return -1;
+    }
+
+    engine.run(frameCount, frameTime);
+
+    std::cout << "Simulated " << engine.getClockTime() << "s in " << engine.getStepCount() << " steps, "
+              << engine.getGamesPlayed() << " games finished, "
+              << engine.world.EntityManager.GetEntities().size() << " entities alive" << std::endl;
+
+    Profiler::writeChromeTrace("DuckEngineTrace.json");
+    engine.shutdown();
+    return 0;
+}
@@ -1,19 +1,42 @@
 #include "engine/core/Engine.h"
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 #define WIDTH 1920
 #define HEIGHT 1080
 
-int main() {
+// Usage: DuckEngine [--offscreen] [--software-gl] [--compact-gbuffer] [--frames N]
+int main(int argc, char** argv) {
+    bool offscreen = false;
+    bool softwareGL = false;
+    bool compactGBuffer = false;
+    int maxFrames = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--offscreen") == 0) {
+            offscreen = true;
+        } else if (std::strcmp(argv[i], "--software-gl") == 0) {
+            softwareGL = true;
+        } else if (std::strcmp(argv[i], "--compact-gbuffer") == 0) {
+            compactGBuffer = true;
+        } else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            maxFrames = std::atoi(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--offscreen] [--software-gl] [--compact-gbuffer] [--frames N]" << std::endl;
+            return -1;
+        }
+    }
+
     Engine engine;
 
-    if (!engine.initialize(WIDTH, HEIGHT, true)) {
+    if (!engine.initialize(WIDTH, HEIGHT, !offscreen, offscreen, softwareGL, compactGBuffer)) {
         std::cerr << "Failed to initialize engine" << std::endl;
         return -1;
     }
 
-    engine.run();
+    engine.run(maxFrames);
     engine.shutdown();
 
     return 0;
-}
\ No newline at end of file
+}